@@ -162,6 +162,8 @@ QString CustomFunctionData::paramToString(const ModelData * model) const
     return QString("%1").arg(param);
   }
   else if (func==FuncLogs) {
+    if (param < 0)
+      return QString("%1").arg(-param*20) + tr("ms (binary)");
     return QString("%1").arg(param/10.0) + tr("s");
   }
   else if (func==FuncPlaySound) {
@@ -2278,6 +2278,10 @@ class ArmCustomFunctionField: public TransformedField {
           else
             *((uint32_t *)_param) = (fn.param < 2 ? fn.param : fn.param-1);
         }
+        else if (fn.func == FuncLogs) {
+          // negative for the fast (binary) logs, mode and index stay 0
+          *((uint16_t *)_param) = fn.param;
+        }
         else {
           *((uint32_t *)_param) = fn.param;
         }
@@ -2357,6 +2361,10 @@ class ArmCustomFunctionField: public TransformedField {
         else
           fn.param = (value < 2 ? value : value+1);
       }
+      else if (fn.func == FuncLogs) {
+        // negative for the fast (binary) logs
+        fn.param = (int16_t)(uint16_t)value;
+      }
       else {
         fn.param = value;
       }
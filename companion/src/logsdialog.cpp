@@ -23,6 +23,8 @@
 #include "appdata.h"
 #include "ui_logsdialog.h"
 #include "helpers.h"
+#include "progresswidget.h"
+#include <QtNumeric>
 #if defined _MSC_VER || !defined __GNUC__
 #include <windows.h>
 #else
@@ -31,17 +33,23 @@
 
 LogsDialog::LogsDialog(QWidget *parent) :
   QDialog(parent, Qt::WindowTitleHint | Qt::WindowSystemMenuHint),
+  plotFirstRow(0),
+  plotLastRow(0),
+  loadedSession(-1),
+  loadingSession(0),
+  loader(NULL),
   ui(new Ui::LogsDialog),
   tracerMaxAlt(0),
   cursorA(0),
   cursorB(0),
   cursorLine(0)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("logs.png"));
 
+  logsModel = new LogsTableModel(this, logData);
+  ui->logTable->setModel(logsModel);
+
   plotLock=false;
 
   colors.append(Qt::green);
@@ -110,22 +118,46 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), SIGNAL(rangeChanged(QCPRange)), this, SLOT(yAxisChangeRanges(QCPRange)));
+  // decimate the plots again when the time range changes
+  connect(axisRect->axis(QCPAxis::atBottom), SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChangeRange(QCPRange)));
 
   // connect some interaction slots:
   connect(ui->customPlot, SIGNAL(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)), this, SLOT(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)));
   connect(ui->customPlot, SIGNAL(axisDoubleClick(QCPAxis*,QCPAxis::SelectablePart,QMouseEvent*)), this, SLOT(axisLabelDoubleClick(QCPAxis*,QCPAxis::SelectablePart)));
   connect(ui->customPlot, SIGNAL(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*,QMouseEvent*)), this, SLOT(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*)));
   connect(ui->FieldsTW, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
-  connect(ui->logTable, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
+  connect(ui->logTable->selectionModel(), SIGNAL(selectionChanged(QItemSelection,QItemSelection)), this, SLOT(plotLogs()));
   connect(ui->Reset_PB, SIGNAL(clicked()), this, SLOT(plotLogs()));
   connect(ui->SaveSession_PB, SIGNAL(clicked()), this, SLOT(saveSession()));
 }
 
 LogsDialog::~LogsDialog()
 {
+  if (loader) {
+    loader->stop();
+  }
+  loaderThread.quit();
+  loaderThread.wait();
+  delete loader;
   delete ui;
 }
 
+QVariant LogsTableModel::data(const QModelIndex & index, int role) const
+{
+  if (role == Qt::DisplayRole && index.isValid()) {
+    return logData.cell(index.row(), index.column());
+  }
+  return QVariant();
+}
+
+QVariant LogsTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+    return logData.header.value(section);
+  }
+  return QAbstractTableModel::headerData(section, orientation, role);
+}
+
 void LogsDialog::titleDoubleClick(QMouseEvent *evt, QCPPlotTitle *title)
 {
   // Set the plot title by double clicking on it
@@ -236,93 +268,79 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QVector<int> LogsDialog::filterGePoints(int gpscol)
 {
-  QList<QStringList> result;
-
-  int n = input.count();
-  if (n == 0) {
-    return result;
-  }
-
-  int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
-      gpscol=i;
-    }
-  }
-  if (gpscol == 0) {
-    QMessageBox::critical(this, tr("Error: no GPS data found"),
-      tr("The column containing GPS coordinates must be named \"GPS\".\n\n\
-The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
-    return result;
-  }
+  QVector<int> result;
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  const LogColumn & gps = logData.columns.at(gpscol - 2);
+  QItemSelectionModel * selection = ui->logTable->selectionModel();
+  bool rangeSelected = selection->hasSelection();
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
+  for (int row = 0; row < logData.rowCount(); row++) {
+    if (!rangeSelected || selection->isSelected(logsModel->index(row, 1))) {
 
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
+      GpsCoord coord = extractGpsCoordinates(gps.text(row));
 
       // glitch filter
       if ( glitchFilter.isGlitch(coord) ) {
-        // qDebug() << "filterGePoints(): GPS glitch detected at" << i << coord.latitude << coord.longitude;
+        // qDebug() << "filterGePoints(): GPS glitch detected at" << row << coord.latitude << coord.longitude;
         continue;
       }
 
       // lat long pair filter
       if ( !latLonFilter.isValid(coord) ) {
-        // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << i << coord.latitude << coord.longitude;
+        // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << row << coord.latitude << coord.longitude;
         continue;
       }
 
       // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+      result.append(row);
     }
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << logData.rowCount() << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
-  // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
-  int n = dataPoints.count(); // number of points to export
-  if (n==0) return;
-
+  const QStringList & header = logData.header;
   int gpscol=0, altcol=0, speedcol=0;
   double altMultiplier = 1.0;
 
   QSet<int> nondataCols;
-  for (int i=1; i<dataPoints.at(0).count(); i++) {
+  for (int i=2; i<header.count(); i++) {
     // Long,Lat,Course,GPS Speed,GPS Alt
-    if (dataPoints.at(0).at(i) == "GPS") {
+    if (header.at(i) == "GPS") {
       gpscol=i;
     }
-    if (dataPoints.at(0).at(i).contains("GAlt")) {
+    if (header.at(i).contains("GAlt")) {
       altcol = i;
       nondataCols << i;
-      if (dataPoints.at(0).at(i).contains("(ft)")) {
+      if (header.at(i).contains("(ft)")) {
         altMultiplier = 0.3048;    // feet to meters
       }
     }
-    if (dataPoints.at(0).at(i).contains("GSpd")) {
+    if (header.at(i).contains("GSpd")) {
       speedcol = i;
       nondataCols << i;
     }
   }
 
   if (gpscol==0 ) {
+    QMessageBox::critical(this, tr("Error: no GPS data found"),
+      tr("The column containing GPS coordinates must be named \"GPS\".\n\n\
+The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return;
   }
 
+  // filter data points
+  QVector<int> dataPoints = filterGePoints(gpscol);
+  if (dataPoints.isEmpty()) return;
+
   // qDebug() << "gpscol" << gpscol << "altcol" << altcol << "speedcol" << speedcol << "altMultiplier" << altMultiplier;
   const QString geFilename = generateProcessUniqueTempFileName("flight.kml");
   QFile geFile(geFilename);
@@ -353,9 +371,9 @@ void LogsDialog::exportToGoogleEarth()
   outputStream << "\t\t\t<gx:SimpleArrayField name=\"GPSSpeed\" type=\"float\">\n\t\t\t\t<displayName>GPS Speed</displayName>\n\t\t\t</gx:SimpleArrayField>\n";
 
   // declare additional fields
-  for (int i=0; i<dataPoints.at(0).count()-2; i++) {
+  for (int i=0; i<header.count()-2; i++) {
     if (ui->FieldsTW->item(i, 0) && ui->FieldsTW->item(i, 0)->isSelected() && !nondataCols.contains(i+2)) {
-      QString origName = dataPoints.at(0).at(i+2);
+      QString origName = header.at(i+2);
       QString safeName = origName;
       safeName.replace(" ","_");
       outputStream << "\t\t\t<gx:SimpleArrayField name=\""<< safeName <<"\" ";
@@ -378,17 +396,17 @@ void LogsDialog::exportToGoogleEarth()
   outputStream << "\n\t\t\t\t\t<altitudeMode>absolute</altitudeMode>\n";
 
   // time data points
-  for (int i=1; i<n; i++) {
-    QString tstamp=dataPoints.at(i).at(0)+QString("T")+dataPoints.at(i).at(1)+QString("Z");
+  foreach (int row, dataPoints) {
+    QString tstamp=logData.cell(row, 0)+QString("T")+logData.cell(row, 1)+QString("Z");
     outputStream << "\t\t\t\t\t<when>"<< tstamp <<"</when>\n";
   }
 
   // coordinate data points
   outputStream.setRealNumberNotation(QTextStream::FixedNotation);
   outputStream.setRealNumberPrecision(8);
-  for (int i=1; i<n; i++) {
-    GpsCoord coord = extractGpsCoordinates(dataPoints.at(i).at(gpscol));
-    int altitude = altcol ? (dataPoints.at(i).at(altcol).toFloat() * altMultiplier) : 0;
+  foreach (int row, dataPoints) {
+    GpsCoord coord = extractGpsCoordinates(logData.cell(row, gpscol));
+    int altitude = altcol ? (logData.columns.at(altcol-2).value(row) * altMultiplier) : 0;
     outputStream << "\t\t\t\t\t<gx:coord>" << coord.longitude << " " << coord.latitude << " " << altitude << " </gx:coord>\n" ;
   }
 
@@ -398,20 +416,20 @@ void LogsDialog::exportToGoogleEarth()
   if (speedcol) {
     // gps speed data points
     outputStream << "\t\t\t\t\t\t\t<gx:SimpleArrayData name=\"GPSSpeed\">\n";
-    for (int i=1; i<n; i++) {
-      outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< dataPoints.at(i).at(speedcol) <<"</gx:value>\n";
+    foreach (int row, dataPoints) {
+      outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< logData.cell(row, speedcol) <<"</gx:value>\n";
     }
     outputStream << "\t\t\t\t\t\t\t</gx:SimpleArrayData>\n";
   }
 
   // add values for additional fields
-  for (int i=0; i<dataPoints.at(0).count()-2; i++) {
+  for (int i=0; i<header.count()-2; i++) {
     if (ui->FieldsTW->item(i, 0) && ui->FieldsTW->item(i, 0)->isSelected() && !nondataCols.contains(i+2)) {
-      QString safeName = dataPoints.at(0).at(i+2);;
+      QString safeName = header.at(i+2);
       safeName.replace(" ","_");
       outputStream << "\t\t\t\t\t\t\t<gx:SimpleArrayData name=\""<< safeName <<"\">\n";
-      for (int j=1; j<n; j++) {
-        outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< dataPoints.at(j).at(i+2) <<"</gx:value>\n";
+      foreach (int row, dataPoints) {
+        outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< logData.cell(row, i+2) <<"</gx:value>\n";
       }
       outputStream << "\t\t\t\t\t\t\t</gx:SimpleArrayData>\n";
     }
@@ -571,143 +589,195 @@ void LogsDialog::on_fileOpen_BT_clicked()
   if (!fileName.isEmpty()) {
     g.logDir(fileName);
     ui->FileName_LE->setText(fileName);
-    if (cvsFileParse()) {
-      ui->FieldsTW->clear();
-      ui->logTable->clear();
-      ui->FieldsTW->setShowGrid(false);
-      ui->FieldsTW->setContentsMargins(0,0,0,0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count()-2);
-      ui->FieldsTW->setColumnCount(1);
-      ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
-      ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-      for (int i=2; i<csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
-        ui->FieldsTW->setItem(i-2, 0, item);
-      }
-      ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count()-1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
-
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i=1; i<csvlog.count(); i++) {
-        for (int j=0; j<csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
 
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-      QVarLengthArray<int> sizes;
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        sizes.append(ui->logTable->columnWidth(i));
-      }
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        ui->logTable->setColumnWidth(i, sizes.at(i));
-      }
-    }
+    plotLock = true;
+    logsModel->beginUpdate();
+    logData.clear();
+    logsModel->endUpdate();
+    ui->FieldsTW->clear();
+    ui->FieldsTW->setRowCount(0);
+    removeAllGraphs();
+    loadedSession = -1;
+    // the sessions are listed at once when the log has a valid index
+    logIndex.clear();
+    logIndex.load(fileName);
+    setFlightSessions();
+    plotLock = false;
+
+    loadLogs(0);
   }
 }
 
-void LogsDialog::saveSession()
+void LogsDialog::loadLogs(int session)
 {
-  int index = ui->sessions_CB->currentIndex();
-  // ignore index 0 is its all sessions combined
-  if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
-    }
-    // save the filtered records to a new file
-    QString newFilename = logFilename;
-    newFilename.append(QString("-Session%1.csv").arg(index));
-    QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
-    QFile data(filename);
-    if(data.open(QFile::WriteOnly |QFile::Truncate)) {
-      QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
-      }
-    }
-    sessionCsvLog.clear();
+  QString fileName = ui->FileName_LE->text();
+  qint64 start = 0;
+  qint64 end = -1;
+  if (session > 0) {
+    const LogSession & range = logIndex.sessions.at(session - 1);
+    start = range.start;
+    end = range.end;
+  }
+
+  ui->fileOpen_BT->setEnabled(false);
+
+  progressDialog = new ProgressDialog(this, tr("Loading logs"), CompanionIcon("logs.png"));
+  progressDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+  ProgressWidget * progress = progressDialog->progress();
+  progress->setInfo(QFileInfo(fileName).fileName());
+  progress->setMaximum(100);
+
+  // move the loader to its own thread, we only use signals/slots from here on
+  loader = new LogsLoader(fileName, start, end);
+  loader->moveToThread(&loaderThread);
+  loadingSession = session;
+
+  connect(this,                  &LogsDialog::startLoading,  loader,                &LogsLoader::run);
+  connect(loader,                &LogsLoader::started,       progressDialog.data(), &ProgressDialog::setProcessStarted);
+  connect(loader,                &LogsLoader::progressStep,  progress,              &ProgressWidget::setValue);
+  connect(loader,                &LogsLoader::finished,      this,                  &LogsDialog::onLogsLoaded);
+  // the loader is busy in run(), the stop request can't wait in its events queue
+  connect(progressDialog.data(), &ProgressDialog::rejected,  loader,                &LogsLoader::stop, Qt::DirectConnection);
+
+  if (!loaderThread.isRunning()) {
+    loaderThread.start();
   }
+  emit startLoading();
 }
 
-bool LogsDialog::cvsFileParse()
+void LogsDialog::stopLoading()
 {
-  QFile file(ui->FileName_LE->text());
-  int errors=0;
-  int lines=-1;
+  // the dialog first, its rejected() signal goes straight to the loader
+  if (progressDialog) {
+    progressDialog->close();
+  }
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
-    return false;
+  if (loader) {
+    loader->stop();
+    disconnect(this, 0, loader, 0);
+    loader->disconnect(this);
+    // run() returns before it is deleted in its thread
+    loader->deleteLater();
+    loader = NULL;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
 
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
+  ui->fileOpen_BT->setEnabled(true);
+}
 
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
+void LogsDialog::onLogsLoaded(bool success)
+{
+  // a finished() signal already queued when the loader was stopped
+  if (sender() != loader) {
+    return;
+  }
 
-    logFilename = QFileInfo(file.fileName()).baseName();
+  const QStringList header = logData.header;
+  LogData & result = loader->data();
+  if (success && result.rowCount() > 0) {
+    logsModel->beginUpdate();
+    logData = result;
+    logsModel->endUpdate();
+    if (loadingSession == 0) {
+      logIndex = loader->index();
+    }
+  }
+  else {
+    success = false;
   }
 
-  file.close();
-  if (errors > 1) {
-    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
+  int session = loadingSession;
+  stopLoading();
+
+  if (!success) {
+    return;
   }
 
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
-    return false;
+  loadedSession = session;
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
+
+  if (logData.invalidLines > 1) {
+    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(logData.invalidLines).arg(logData.lines));
   }
 
   plotLock = true;
-  setFlightSessions();
+  if (session == 0) {
+    setFlightSessions();
+  }
+  // the fields (and their selection) are kept when only the session changes
+  if (logData.header != header) {
+    showLogs();
+  }
   plotLock = false;
 
-  return true;
+  selectSession(ui->sessions_CB->currentIndex());
+}
+
+void LogsDialog::showLogs()
+{
+  ui->FieldsTW->clear();
+  ui->FieldsTW->setShowGrid(false);
+  ui->FieldsTW->setContentsMargins(0,0,0,0);
+  ui->FieldsTW->setRowCount(logData.columnCount()-2);
+  ui->FieldsTW->setColumnCount(1);
+  ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
+  ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+  for (int i=2; i<logData.columnCount(); i++) {
+    QTableWidgetItem* item= new QTableWidgetItem(logData.header.at(i));
+    // the range of the whole log, from its index
+    if (i-2 < logIndex.minimums.count() && !qIsNaN(logIndex.minimums.at(i-2))) {
+      item->setToolTip(tr("Min %1, max %2").arg(logIndex.minimums.at(i-2)).arg(logIndex.maximums.at(i-2)));
+    }
+    ui->FieldsTW->setItem(i-2, 0, item);
+  }
+  ui->FieldsTW->resizeRowsToContents();
+
+  ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+  QVarLengthArray<int> sizes;
+  for (int i = 0; i < logsModel->columnCount(); i++) {
+    sizes.append(ui->logTable->columnWidth(i));
+  }
+  ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+  for (int i = 0; i < logsModel->columnCount(); i++) {
+    ui->logTable->setColumnWidth(i, sizes.at(i));
+  }
+}
+
+bool LogsDialog::getSessionRows(int index, int & first, int & last)
+{
+  if (index == loadedSession) {
+    first = 0;
+    last = logData.rowCount();
+    return true;
+  }
+  else if (loadedSession == 0 && index > 0 && index <= logData.sessions.count()) {
+    const LogSession & session = logData.sessions.at(index - 1);
+    first = session.firstRow;
+    last = session.firstRow + session.rows;
+    return true;
+  }
+  return false;
+}
+
+void LogsDialog::saveSession()
+{
+  int index = ui->sessions_CB->currentIndex();
+  int first, last;
+  // ignore index 0 is its all sessions combined
+  if (index > 0 && getSessionRows(index, first, last)) {
+    // save the session records to a new file
+    QString newFilename = logFilename;
+    newFilename.append(QString("-Session%1.csv").arg(index));
+    QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
+    QFile data(filename);
+    if(data.open(QFile::WriteOnly |QFile::Truncate)) {
+      QTextStream output(&data);
+      // add CSV headers from first row of source file
+      output << logData.header.join(",") << '\n';
+      for (int row = first; row < last; row++) {
+        output << logData.record(row).join(",") << '\n';
+      }
+    }
+  }
 }
 
 struct FlightSession {
@@ -715,14 +785,6 @@ struct FlightSession {
   QDateTime end;
 };
 
-QDateTime LogsDialog::getRecordTimeStamp(int index)
-{
-  QString tstamp = csvlog.at(index).at(0) + " " + csvlog.at(index).at(1);
-  if (csvlog.at(index).at(1).contains("."))
-    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz");
-  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss");
-}
-
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
 {
   int secs = start.secsTo(end);
@@ -740,61 +802,56 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
-  // qDebug() << "records" << n;
-
-  // find session breaks
-  QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
-    }
-    lastvalue = tmp;
+  // the sessions of the index, read with the log or from its .idx file
+  const QVector<LogSession> & sessions = logIndex.sessions;
+  int noSesions = sessions.count();
+  if (noSesions == 0) {
+    return;
   }
-  sessions.push_back(n-1);
 
   //now construct a list of sessions with their times
   //total time
-  int noSesions = sessions.size()-1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("total duration ") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n-1)) + ">";
+  label += " <" + tr("total duration ") + generateDuration(QDateTime::fromMSecsSinceEpoch(sessions.first().startTime), QDateTime::fromMSecsSinceEpoch(sessions.last().endTime)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
-  if (sessions.size() > 2) {
-    for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1)+1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+  if (noSesions > 1) {
+    foreach (const LogSession & session, sessions) {
+      QDateTime sessionStart = QDateTime::fromMSecsSinceEpoch(session.startTime);
+      QDateTime sessionEnd = QDateTime::fromMSecsSinceEpoch(session.endTime);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
-      ui->sessions_CB->addItem(label, sessions.at(i-1));
-      // qDebug() << "added label" << label << sessions.at(i-1);
+      ui->sessions_CB->addItem(label);
     }
   }
 }
 
 void LogsDialog::on_sessions_CB_currentIndexChanged(int index)
 {
-  if (plotLock) return;
+  if (plotLock || index < 0) return;
+
+  int first, last;
+  if (!getSessionRows(index, first, last) && (index > 0 || loadedSession != 0)) {
+    // the session isn't in the loaded rows, read its part of the log
+    stopLoading();
+    loadLogs(index);
+    return;
+  }
+
+  selectSession(index);
+}
+
+void LogsDialog::selectSession(int index)
+{
   plotLock = true;
 
   ui->logTable->clearSelection();
 
-  if (index != 0) {
-    int bottom;
-    if (index < ui->sessions_CB->count() - 1) {
-      bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
-    } else {
-      bottom = ui->logTable->rowCount();
-    }
-
-    QModelIndex topLeft = ui->logTable->model()->index(
-      ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
-    QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+  int first, last;
+  if (index > 0 && getSessionRows(index, first, last)) {
+    QModelIndex topLeft = ui->logTable->model()->index(first, 0 , QModelIndex());
+    QModelIndex bottomRight = ui->logTable->model()->index(last - 1, logsModel->columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -818,70 +875,60 @@ void LogsDialog::plotLogs()
     return;
   }
 
-  plotsCollection plots;
+  plots.coords.clear();
+  plotRows.clear();
 
+  // the plots are decimated on a contiguous rows range (all the rows, or a
+  // session), any other selection is plotted as is
   QModelIndexList selection = ui->logTable->selectionModel()->selectedRows();
-  int rowCount = selection.length();
-  bool hasLogSelection;
-  QVarLengthArray<int> selectedRows;
-
-  if (rowCount) {
-    hasLogSelection = true;
+  if (selection.length()) {
     foreach (QModelIndex index, selection) {
-      selectedRows.append(index.row());
+      plotRows.append(index.row());
+    }
+    qSort(plotRows.begin(), plotRows.end());
+    plotFirstRow = plotRows.first();
+    plotLastRow = plotRows.last() + 1;
+    if (plotLastRow - plotFirstRow == plotRows.count()) {
+      plotRows.clear();
     }
-    qSort(selectedRows.begin(), selectedRows.end());
   } else {
-    hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
+    plotFirstRow = 0;
+    plotLastRow = logData.rowCount();
   }
 
   plots.min_x = QDateTime::currentDateTime().toTime_t();
   plots.max_x = 0;
 
+  for (int row = plotFirstRow; row < plotLastRow; row++) {
+    double time = logData.time(row);
+    if (plots.min_x > time) plots.min_x = time;
+    if (plots.max_x < time) plots.max_x = time;
+  }
+
   foreach (QTableWidgetItem *plot, ui->FieldsTW->selectedItems()) {
     coords_t plotCoords;
-    int plotColumn = plot->row() + 2; // Date and Time first
 
     plotCoords.min_y = INVALID_MIN;
     plotCoords.max_y = INVALID_MAX;
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
-
-    for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
-      }
-
-      y = logValue->text().toDouble();
-      plotCoords.y.push_back(y);
-
-      if (plotCoords.min_y > y) plotCoords.min_y = y;
-      if (plotCoords.max_y < y) plotCoords.max_y = y;
-
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
+    plotCoords.column = plot->row(); // Date and Time not included
+    plotCoords.offset = 0;
+    plotCoords.scale = 1;
+
+    // the min and max values are in the points of the coarsest decimation
+    QVector<double> x, y;
+    if (plotRows.isEmpty()) {
+      logData.decimate(plotCoords.column, plotFirstRow, plotLastRow, 1, x, y);
+    }
+    else {
+      foreach (int row, plotRows) {
+        y.append(logData.columns.at(plotCoords.column).value(row));
       }
-      plotCoords.x.push_back(time);
-
-      if (plots.min_x > time) plots.min_x = time;
-      if (plots.max_x < time) plots.max_x = time;
+    }
+    foreach (double value, y) {
+      if (plotCoords.min_y > value) plotCoords.min_y = value;
+      if (plotCoords.max_y < value) plotCoords.max_y = value;
     }
 
     double range_inc = (plotCoords.max_y - plotCoords.min_y) / 100;
@@ -957,10 +1004,8 @@ void LogsDialog::plotLogs()
     for (int i = 0; i < plots.coords.size(); i++) {
       plots.coords[i].yaxis = firstLeft;
 
-      double factor = 100 / (plots.coords.at(i).max_y - plots.coords.at(i).min_y);
-      for (int j = 0; j < plots.coords.at(i).y.count(); j++) {
-        plots.coords[i].y[j] = factor * (plots.coords.at(i).y.at(j) - plots.coords.at(i).min_y);
-      }
+      plots.coords[i].offset = plots.coords.at(i).min_y;
+      plots.coords[i].scale = 100 / (plots.coords.at(i).max_y - plots.coords.at(i).min_y);
     }
   } else {
     for (int i = firstRight; i < AXES_LIMIT; i++) {
@@ -1045,8 +1090,7 @@ void LogsDialog::plotLogs()
         break;
     }
 
-    ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
-      plots.coords.at(i).y);
+    decimatePlot(i);
     pen.setColor(colors.at(i % colors.size()));
     ui->customPlot->graph(i)->setPen(pen);
 
@@ -1066,6 +1110,48 @@ void LogsDialog::plotLogs()
   ui->customPlot->replot();
 }
 
+// The points of a plot in the visible time range, with one more on each side
+// for the lines to reach the edges, decimated to about 2 points per pixel
+void LogsDialog::decimatePlot(int index)
+{
+  coords_t & coords = plots.coords[index];
+
+  if (plotRows.isEmpty()) {
+    QCPRange range = axisRect->axis(QCPAxis::atBottom)->range();
+    int first = qMax(plotFirstRow, logData.findRow(range.lower, plotFirstRow, plotLastRow) - 1);
+    int last = qMin(plotLastRow, logData.findRow(range.upper, plotFirstRow, plotLastRow) + 1);
+    logData.decimate(coords.column, first, last, qMax(axisRect->width(), 100), coords.x, coords.y);
+  }
+  else {
+    coords.x.clear();
+    coords.y.clear();
+    foreach (int row, plotRows) {
+      coords.x.append(logData.time(row));
+      coords.y.append(logData.columns.at(coords.column).value(row));
+    }
+  }
+
+  if (plots.tooManyRanges) {
+    for (int i = 0; i < coords.y.count(); i++) {
+      coords.y[i] = (coords.y.at(i) - coords.offset) * coords.scale;
+    }
+  }
+
+  ui->customPlot->graph(index)->setData(coords.x, coords.y);
+}
+
+void LogsDialog::xAxisChangeRange(QCPRange range)
+{
+  // the plots are not there yet while plotLogs() sets the range
+  if (!plotRows.isEmpty() || ui->customPlot->graphCount() != plots.coords.size()) {
+    return;
+  }
+
+  for (int i = 0; i < plots.coords.size(); i++) {
+    decimatePlot(i);
+  }
+}
+
 void LogsDialog::yAxisChangeRanges(QCPRange range)
 {
   if (axisRect->axis(QCPAxis::atRight)->visible()) {
@@ -24,6 +24,8 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include "logsloader.h"
+#include "progressdialog.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -32,6 +34,44 @@ namespace Ui {
   class LogsDialog;
 }
 
+// The logs table, read straight from the columns rather than from an item per value
+class LogsTableModel : public QAbstractTableModel
+{
+  public:
+    LogsTableModel(QObject * parent, const LogData & logData):
+      QAbstractTableModel(parent),
+      logData(logData)
+    {
+    }
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override
+    {
+      return parent.isValid() ? 0 : logData.rowCount();
+    }
+
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override
+    {
+      return parent.isValid() ? 0 : logData.columnCount();
+    }
+
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // around the changes of the data
+    void beginUpdate()
+    {
+      beginResetModel();
+    }
+
+    void endUpdate()
+    {
+      endResetModel();
+    }
+
+  protected:
+    const LogData & logData;
+};
+
 class LogsDialog : public QDialog
 {
   Q_OBJECT
@@ -45,11 +85,14 @@ class LogsDialog : public QDialog
   };
 
   struct coords_t {
-    QVector<double> x, y;
+    QVector<double> x, y;   // the points of the visible range, decimated
     double min_y;
     double max_y;
     yaxes_t yaxis;
     QString name;
+    int column;             // in the log columns
+    double offset;          // y = (value - offset) * scale
+    double scale;
   };
 
   struct minMax_t {
@@ -68,6 +111,9 @@ public:
   explicit LogsDialog(QWidget *parent = 0);
   ~LogsDialog();
 
+signals:
+  void startLoading();
+
 private slots:
   void titleDoubleClick(QMouseEvent *evt, QCPPlotTitle *title);
   void axisLabelDoubleClick(QCPAxis* axis, QCPAxis::SelectablePart part);
@@ -82,9 +128,22 @@ private slots:
   void on_sessions_CB_currentIndexChanged(int index);
   void on_mapsButton_clicked();
   void yAxisChangeRanges(QCPRange range);
+  void xAxisChangeRange(QCPRange range);
+  void onLogsLoaded(bool success);
 
 private:
-  QList<QStringList> csvlog;
+  LogData logData;
+  LogsTableModel * logsModel;
+  plotsCollection plots;
+  QVector<int> plotRows;    // the plotted rows when not contiguous
+  int plotFirstRow;         // otherwise the plotted rows range
+  int plotLastRow;
+  LogIndex logIndex;
+  int loadedSession;        // the sessions combo index of the rows, 0 for the whole log
+  int loadingSession;
+  QThread loaderThread;
+  LogsLoader * loader;
+  QPointer<ProgressDialog> progressDialog;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -102,13 +161,17 @@ private:
   QCPItemTracer * cursorB;
   QCPItemStraightLine * cursorLine;
 
-  bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  void loadLogs(int session);
+  void stopLoading();
+  void showLogs();
+  QVector<int> filterGePoints(int gpscol);
   void exportToGoogleEarth();
-  QDateTime getRecordTimeStamp(int index);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
   void setFlightSessions();
+  bool getSessionRows(int index, int & first, int & last);
+  void selectSession(int index);
 
+  void decimatePlot(int index);
   void addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph);
   void countNumberOfThrows(const coords_t & c, QCPGraph * graph);
   void addCursor(QCPItemTracer ** cursor, QCPGraph * graph, const QColor & color);
@@ -0,0 +1,594 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logsloader.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QtNumeric>
+#include <QVarLengthArray>
+#include <string.h>
+#include <algorithm>
+
+#define LOGS_MAX_DIGITS       18    // what a qint64 always holds
+#define LOGS_STOP_CHECK_MASK  0x3FF // check for a stop request every 1024 lines
+#define LOGS_PYRAMID_FACTOR   4
+#define LOGS_SESSION_GAP      60    // s without records between two sessions
+#define LOGS_INDEX_VERSION    1
+
+static const double powersOf10[LOGS_MAX_DIGITS + 1] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+  1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+};
+
+// Parses a decimal number as written by the radio ("-12", "3.25"), without
+// the QString conversion and the locale handling of QString::toDouble()
+static bool parseDecimal(const char * str, int len, qint64 & mantissa, int & decimals)
+{
+  int i = 0;
+  bool negative = false;
+  if (len > 0 && (str[0] == '-' || str[0] == '+')) {
+    negative = (str[0] == '-');
+    i++;
+  }
+
+  qint64 value = 0;
+  int digits = 0;
+  decimals = -1;
+  for (; i < len; i++) {
+    char c = str[i];
+    if (c >= '0' && c <= '9') {
+      if (++digits > LOGS_MAX_DIGITS)
+        return false;
+      value = value * 10 + (c - '0');
+      if (decimals >= 0)
+        decimals++;
+    }
+    else if (c == '.' && decimals < 0) {
+      decimals = 0;
+    }
+    else {
+      return false;
+    }
+  }
+
+  if (digits == 0)
+    return false;
+
+  mantissa = negative ? -value : value;
+  if (decimals < 0)
+    decimals = 0;
+  return true;
+}
+
+static int parseDigits(const char * str, int count)
+{
+  int result = 0;
+  for (int i = 0; i < count; i++) {
+    if (str[i] < '0' || str[i] > '9')
+      return -1;
+    result = result * 10 + (str[i] - '0');
+  }
+  return result;
+}
+
+int LogColumn::count() const
+{
+  switch (type) {
+    case Integer:
+      return integers.count();
+    case Double:
+      return doubles.count();
+    default:
+      return texts.count();
+  }
+}
+
+double LogColumn::value(int row) const
+{
+  switch (type) {
+    case Integer:
+      return integers.at(row);
+    case Double:
+      return doubles.at(row);
+    default:
+      return texts.at(row).toDouble();
+  }
+}
+
+QString LogColumn::text(int row) const
+{
+  switch (type) {
+    case Integer:
+      return QString::number(integers.at(row));
+    case Double:
+      return QString::number(doubles.at(row), 'f', decimals);
+    default:
+      return texts.at(row);
+  }
+}
+
+// Empty values are read as 0 in numeric columns, as the plots always did
+void LogColumn::append(const char * str, int len)
+{
+  if (type != Text) {
+    qint64 mantissa = 0;
+    int digits = 0;
+    if (len == 0 || parseDecimal(str, len, mantissa, digits)) {
+      if (digits > 0 && type == Integer) {
+        toDouble();
+      }
+      if (type == Integer) {
+        integers.append(mantissa);
+      }
+      else {
+        if (digits > decimals)
+          decimals = digits;
+        doubles.append(mantissa / powersOf10[digits]);
+      }
+      return;
+    }
+    toText();
+  }
+  texts.append(QString::fromUtf8(str, len));
+}
+
+void LogColumn::toDouble()
+{
+  doubles.reserve(integers.capacity());
+  foreach (qint64 value, integers) {
+    doubles.append(value);
+  }
+  integers = QVector<qint64>();
+  type = Double;
+}
+
+void LogColumn::toText()
+{
+  int rows = count();
+  texts.reserve(rows);
+  for (int row = 0; row < rows; row++) {
+    texts.append(text(row));
+  }
+  integers = QVector<qint64>();
+  doubles = QVector<double>();
+  type = Text;
+}
+
+void LogColumn::buildPyramid()
+{
+  pyramid.clear();
+  if (type == Text)
+    return;
+
+  const int rows = count();
+  QVector<Bucket> level;
+  for (int first = 0; first < rows; first += LOGS_PYRAMID_FACTOR) {
+    Bucket bucket = { first, first };
+    for (int row = first + 1; row < qMin(first + LOGS_PYRAMID_FACTOR, rows); row++) {
+      double y = value(row);
+      if (y < value(bucket.minRow))
+        bucket.minRow = row;
+      if (y > value(bucket.maxRow))
+        bucket.maxRow = row;
+    }
+    level.append(bucket);
+  }
+
+  while (level.count() > 1) {
+    pyramid.append(level);
+    QVector<Bucket> upper;
+    for (int first = 0; first < level.count(); first += LOGS_PYRAMID_FACTOR) {
+      Bucket bucket = level.at(first);
+      for (int i = first + 1; i < qMin(first + LOGS_PYRAMID_FACTOR, level.count()); i++) {
+        if (value(level.at(i).minRow) < value(bucket.minRow))
+          bucket.minRow = level.at(i).minRow;
+        if (value(level.at(i).maxRow) > value(bucket.maxRow))
+          bucket.maxRow = level.at(i).maxRow;
+      }
+      upper.append(bucket);
+    }
+    level = upper;
+  }
+  pyramid.append(level);
+}
+
+QString LogData::cell(int row, int column) const
+{
+  if (column == 0)
+    return timestamp(row).toString("yyyy-MM-dd");
+  else if (column == 1)
+    return timestamp(row).toString(milliseconds ? "HH:mm:ss.zzz" : "HH:mm:ss");
+  else
+    return columns.at(column - 2).text(row);
+}
+
+QStringList LogData::record(int row) const
+{
+  QStringList result;
+  for (int column = 0; column < columnCount(); column++) {
+    result.append(cell(row, column));
+  }
+  return result;
+}
+
+int LogData::findRow(double time, int first, int last) const
+{
+  return std::lower_bound(timestamps.constBegin() + first, timestamps.constBegin() + last, qint64(time * 1000)) - timestamps.constBegin();
+}
+
+// The finest pyramid level which has no more than the given buckets between
+// the two rows gives the points, the rows of the buckets partly in the range
+// being read one by one. As the rows of the min and max values are kept,
+// the points are real ones, at their time
+void LogData::decimate(int column, int first, int last, int buckets, QVector<double> & x, QVector<double> & y) const
+{
+  const LogColumn & values = columns.at(column);
+  x.clear();
+  y.clear();
+
+  int level = -1;
+  int size = 1;
+  if (last - first > 2 * buckets) {
+    for (level = 0, size = LOGS_PYRAMID_FACTOR; level < values.pyramid.count() - 1; level++, size *= LOGS_PYRAMID_FACTOR) {
+      if ((last - first) / size <= buckets)
+        break;
+    }
+  }
+
+  if (level < 0 || level >= values.pyramid.count()) {
+    x.reserve(last - first);
+    y.reserve(last - first);
+    for (int row = first; row < last; row++) {
+      x.append(time(row));
+      y.append(values.value(row));
+    }
+    return;
+  }
+
+  x.reserve(2 * ((last - first) / size + 2));
+  y.reserve(2 * ((last - first) / size + 2));
+  for (int row = first; row < last; ) {
+    int index = row / size;
+    int bucketLast = qMin((index + 1) * size, last);
+    LogColumn::Bucket bucket;
+    if (row == index * size && bucketLast == (index + 1) * size) {
+      bucket = values.pyramid.at(level).at(index);
+    }
+    else {
+      bucket.minRow = bucket.maxRow = row;
+      for (int i = row + 1; i < bucketLast; i++) {
+        if (values.value(i) < values.value(bucket.minRow))
+          bucket.minRow = i;
+        if (values.value(i) > values.value(bucket.maxRow))
+          bucket.maxRow = i;
+      }
+    }
+    int rows[2] = { qMin(bucket.minRow, bucket.maxRow), qMax(bucket.minRow, bucket.maxRow) };
+    for (int i = 0; i < (rows[0] == rows[1] ? 1 : 2); i++) {
+      x.append(time(rows[i]));
+      y.append(values.value(rows[i]));
+    }
+    row = bucketLast;
+  }
+}
+
+void LogData::clear()
+{
+  header.clear();
+  timestamps.clear();
+  columns.clear();
+  sessions.clear();
+  milliseconds = false;
+  lines = 0;
+  invalidLines = 0;
+}
+
+QString LogIndex::fileName(const QString & logFileName)
+{
+  QFileInfo info(logFileName);
+  return info.path() + "/" + info.completeBaseName() + ".idx";
+}
+
+QByteArray LogIndex::headerHash(const QByteArray & header)
+{
+  return QCryptographicHash::hash(header, QCryptographicHash::Md5).toHex();
+}
+
+void LogIndex::clear()
+{
+  size = 0;
+  modified = 0;
+  header.clear();
+  sessions.clear();
+  minimums.clear();
+  maximums.clear();
+}
+
+bool LogIndex::load(const QString & logFileName)
+{
+  clear();
+
+  QFile file(fileName(logFileName));
+  QFile log(logFileName);
+  if (!file.open(QIODevice::ReadOnly) || !log.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+  if (json["version"].toInt() != LOGS_INDEX_VERSION ||
+      (qint64)json["size"].toDouble() != log.size() ||
+      (qint64)json["modified"].toDouble() != QFileInfo(log).lastModified().toMSecsSinceEpoch() ||
+      json["header"].toString().toLatin1() != headerHash(log.readLine().trimmed())) {
+    return false;
+  }
+
+  size = log.size();
+  modified = (qint64)json["modified"].toDouble();
+  header = json["header"].toString().toLatin1();
+
+  foreach (const QJsonValue & value, json["sessions"].toArray()) {
+    QJsonObject object = value.toObject();
+    LogSession session;
+    session.firstRow = object["row"].toInt();
+    session.rows = object["rows"].toInt();
+    session.start = (qint64)object["start"].toDouble();
+    session.end = (qint64)object["end"].toDouble();
+    session.startTime = (qint64)object["startTime"].toDouble();
+    session.endTime = (qint64)object["endTime"].toDouble();
+    sessions.append(session);
+  }
+
+  foreach (const QJsonValue & value, json["columns"].toArray()) {
+    QJsonObject object = value.toObject();
+    minimums.append(object["min"].isDouble() ? object["min"].toDouble() : qQNaN());
+    maximums.append(object["max"].isDouble() ? object["max"].toDouble() : qQNaN());
+  }
+
+  return !sessions.isEmpty();
+}
+
+bool LogIndex::save(const QString & logFileName) const
+{
+  QJsonArray jsonSessions;
+  foreach (const LogSession & session, sessions) {
+    QJsonObject object;
+    object["row"] = session.firstRow;
+    object["rows"] = session.rows;
+    object["start"] = (double)session.start;
+    object["end"] = (double)session.end;
+    object["startTime"] = (double)session.startTime;
+    object["endTime"] = (double)session.endTime;
+    jsonSessions.append(object);
+  }
+
+  QJsonArray jsonColumns;
+  for (int i = 0; i < minimums.count(); i++) {
+    QJsonObject object;
+    // no NaN in JSON, null for the text columns
+    object["min"] = qIsNaN(minimums.at(i)) ? QJsonValue() : QJsonValue(minimums.at(i));
+    object["max"] = qIsNaN(maximums.at(i)) ? QJsonValue() : QJsonValue(maximums.at(i));
+    jsonColumns.append(object);
+  }
+
+  QJsonObject json;
+  json["version"] = LOGS_INDEX_VERSION;
+  json["size"] = (double)size;
+  json["modified"] = (double)modified;
+  json["header"] = QString::fromLatin1(header);
+  json["sessions"] = jsonSessions;
+  json["columns"] = jsonColumns;
+
+  QFile file(fileName(logFileName));
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+  return file.write(QJsonDocument(json).toJson(QJsonDocument::Compact)) > 0;
+}
+
+LogsLoader::LogsLoader(const QString & filename, qint64 start, qint64 end):
+  filename(filename),
+  start(start),
+  end(end),
+  stopping(false),
+  lastDateHourMs(0)
+{
+}
+
+void LogsLoader::stop()
+{
+  QMutexLocker locker(&stopReqMutex);
+  stopping = true;
+}
+
+bool LogsLoader::isStopRequested()
+{
+  QMutexLocker locker(&stopReqMutex);
+  return stopping;
+}
+
+void LogsLoader::run()
+{
+  emit started();
+
+  result.clear();
+  lastDateHour.clear();
+
+  // not in text mode, for the file offsets of the sessions
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    emit finished(false);
+    return;
+  }
+
+  QByteArray line = file.readLine().trimmed();
+  if (!line.startsWith("Date,Time")) {
+    emit finished(false);
+    return;
+  }
+  const QByteArray header = line;
+
+  if (start > 0 && !file.seek(start)) {
+    emit finished(false);
+    return;
+  }
+
+  result.header = QString::fromUtf8(line).split(',');
+  for (int i = 2; i < result.header.count(); i++) {
+    result.columns.append(LogColumn(result.header.at(i)));
+  }
+
+  const int fields = result.header.count();
+  const qint64 first = file.pos();
+  const qint64 size = (end < 0 ? file.size() : end) - first;
+  int percent = 0;
+  QVarLengthArray<int, 128> separators;
+
+  while (!file.atEnd() && (end < 0 || file.pos() < end)) {
+    if ((result.lines & LOGS_STOP_CHECK_MASK) == 0) {
+      if (isStopRequested()) {
+        result.clear();
+        emit finished(false);
+        return;
+      }
+      int progress = size > 0 ? (file.pos() - first) * 100 / size : 100;
+      if (progress != percent) {
+        percent = progress;
+        emit progressStep(percent);
+      }
+    }
+
+    qint64 offset = file.pos();
+    line = file.readLine().trimmed();
+    result.lines++;
+
+    const char * data = line.constData();
+    const int len = line.size();
+    separators.clear();
+    separators.append(-1);
+    for (int i = 0; i < len; i++) {
+      if (data[i] == ',')
+        separators.append(i);
+    }
+    separators.append(len);
+
+    qint64 timestamp;
+    if (separators.count() - 1 != fields ||
+        !parseTimestamp(data, separators[1], data + separators[1] + 1, separators[2] - separators[1] - 1, timestamp)) {
+      result.invalidLines++;
+      continue;
+    }
+
+    if (result.sessions.isEmpty() || (timestamp - result.sessions.last().endTime) / 1000 > LOGS_SESSION_GAP) {
+      LogSession session = { result.rowCount(), 0, offset, offset, timestamp, timestamp };
+      result.sessions.append(session);
+    }
+    LogSession & session = result.sessions.last();
+    session.rows++;
+    session.end = file.pos();
+    session.endTime = timestamp;
+
+    result.timestamps.append(timestamp);
+    for (int i = 2; i < fields; i++) {
+      result.columns[i - 2].append(data + separators[i] + 1, separators[i + 1] - separators[i] - 1);
+    }
+  }
+
+  for (int i = 0; i < result.columns.count(); i++) {
+    if (isStopRequested()) {
+      result.clear();
+      emit finished(false);
+      return;
+    }
+    result.columns[i].buildPyramid();
+  }
+
+  if (start == 0 && end < 0 && result.rowCount() > 0) {
+    saveIndex(header);
+  }
+
+  emit progressStep(100);
+  emit finished(true);
+}
+
+// The range of each column is the min and max of the top of its pyramid
+void LogsLoader::saveIndex(const QByteArray & header)
+{
+  QFileInfo info(filename);
+  logIndex.clear();
+  logIndex.size = info.size();
+  logIndex.modified = info.lastModified().toMSecsSinceEpoch();
+  logIndex.header = LogIndex::headerHash(header);
+  logIndex.sessions = result.sessions;
+  foreach (const LogColumn & column, result.columns) {
+    if (column.pyramid.isEmpty()) {
+      logIndex.minimums.append(qQNaN());
+      logIndex.maximums.append(qQNaN());
+    }
+    else {
+      const LogColumn::Bucket & top = column.pyramid.last().first();
+      logIndex.minimums.append(column.value(top.minRow));
+      logIndex.maximums.append(column.value(top.maxRow));
+    }
+  }
+  logIndex.save(filename);
+}
+
+// "2018-01-01" and "12:34:56.780" (or "12:34:56" in the older logs). The
+// QDateTime conversion, the slow part, is only done when the date or the hour
+// changes, which also keeps the DST changes right
+bool LogsLoader::parseTimestamp(const char * date, int dateLen, const char * time, int timeLen, qint64 & timestamp)
+{
+  if (dateLen != 10 || date[4] != '-' || date[7] != '-' || timeLen < 8 || time[2] != ':' || time[5] != ':')
+    return false;
+
+  int minute = parseDigits(time + 3, 2);
+  int second = parseDigits(time + 6, 2);
+  if (minute < 0 || minute > 59 || second < 0 || second > 59)
+    return false;
+
+  int ms = 0;
+  if (timeLen > 8) {
+    if (time[8] != '.')
+      return false;
+    for (int i = 9, scale = 100; i < timeLen; i++, scale /= 10) {
+      if (time[i] < '0' || time[i] > '9')
+        return false;
+      ms += (time[i] - '0') * scale;
+    }
+    result.milliseconds = true;
+  }
+
+  if (lastDateHour.size() != 12 || memcmp(lastDateHour.constData(), date, 10) || memcmp(lastDateHour.constData() + 10, time, 2)) {
+    QDateTime dateHour(QDate(parseDigits(date, 4), parseDigits(date + 5, 2), parseDigits(date + 8, 2)), QTime(parseDigits(time, 2), 0));
+    if (!dateHour.isValid())
+      return false;
+    lastDateHour = QByteArray(date, 10) + QByteArray(time, 2);
+    lastDateHourMs = dateHour.toMSecsSinceEpoch();
+  }
+
+  timestamp = lastDateHourMs + (minute * 60 + second) * 1000 + ms;
+  return true;
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _LOGSLOADER_H_
+#define _LOGSLOADER_H_
+
+#include <QObject>
+#include <QDateTime>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// One column of a telemetry log, stored with the narrowest type which holds
+// all its values. A column starts as Integer, becomes Double as soon as a
+// value has decimals, and Text (GPS coordinates, logical switches, ...) as
+// soon as a value is not a number
+//
+// The numeric columns also have a min/max pyramid, for the plots of long
+// logs: each level has a bucket per LOGS_PYRAMID_FACTOR buckets of the level
+// below (or rows for the first level), which holds the rows of their min and
+// max values
+class LogColumn
+{
+  public:
+    enum Type {
+      Integer,
+      Double,
+      Text
+    };
+
+    struct Bucket {
+      int minRow;
+      int maxRow;
+    };
+
+    LogColumn(const QString & name = QString()):
+      name(name),
+      type(Integer),
+      decimals(0)
+    {
+    }
+
+    int count() const;
+    double value(int row) const;
+    QString text(int row) const;
+    void append(const char * str, int len);
+    void buildPyramid();
+
+    QString name;
+    Type type;
+    int decimals;   // the most decimals of the values, to write them back as read
+    QVector<qint64> integers;
+    QVector<double> doubles;
+    QVector<QString> texts;
+    QVector< QVector<Bucket> > pyramid;
+
+  protected:
+    void toDouble();
+    void toText();
+};
+
+// A flight session, the records between two gaps of more than a minute
+struct LogSession {
+  int firstRow;
+  int rows;
+  qint64 start;       // the file offsets of its lines
+  qint64 end;
+  qint64 startTime;   // ms since epoch
+  qint64 endTime;
+};
+
+// A telemetry log, the Date and Time columns being merged into the timestamps
+class LogData
+{
+  public:
+    LogData():
+      milliseconds(false),
+      lines(0),
+      invalidLines(0)
+    {
+    }
+
+    int rowCount() const
+    {
+      return timestamps.count();
+    }
+
+    int columnCount() const
+    {
+      return header.count();
+    }
+
+    QDateTime timestamp(int row) const
+    {
+      return QDateTime::fromMSecsSinceEpoch(timestamps.at(row));
+    }
+
+    double time(int row) const
+    {
+      return timestamps.at(row) / 1000.0;
+    }
+
+    // the CSV text of a cell, the columns being numbered as in the header
+    QString cell(int row, int column) const;
+    QStringList record(int row) const;
+    void clear();
+
+    // the first row from the given time, the timestamps being in order
+    int findRow(double time, int first, int last) const;
+    // the points of a column between two rows, at most the min and max of
+    // each of the given number of buckets
+    void decimate(int column, int first, int last, int buckets, QVector<double> & x, QVector<double> & y) const;
+
+    QStringList header;           // all the CSV columns, Date and Time included
+    QVector<qint64> timestamps;   // ms since epoch, in local time as written by the radio
+    QVector<LogColumn> columns;   // the columns after Date and Time
+    QVector<LogSession> sessions;
+    bool milliseconds;            // the Time column has ms
+    int lines;
+    int invalidLines;
+};
+
+// The index of a log, saved next to it (MODEL-2018-01-01.idx), which gives
+// its sessions and the range of its columns without reading it again. It is
+// only valid while the log size, date and header are unchanged
+class LogIndex
+{
+  public:
+    LogIndex():
+      size(0),
+      modified(0)
+    {
+    }
+
+    static QString fileName(const QString & logFileName);
+    static QByteArray headerHash(const QByteArray & header);
+    bool load(const QString & logFileName);
+    bool save(const QString & logFileName) const;
+    void clear();
+
+    qint64 size;
+    qint64 modified;              // ms since epoch
+    QByteArray header;            // the hash of the header line
+    QVector<LogSession> sessions;
+    QVector<double> minimums;     // of each column after Date and Time, NaN for the text ones
+    QVector<double> maximums;
+};
+
+// Parses a CSV log, line by line, straight into the columns. It is meant to
+// run in its own thread, the dialog being updated through the signals. The
+// records may be limited to a range of the file, a session of the index,
+// otherwise the index is written once the whole log is read
+class LogsLoader : public QObject
+{
+    Q_OBJECT
+
+  public:
+    LogsLoader(const QString & filename, qint64 start = 0, qint64 end = -1);
+    LogData & data()
+    {
+      return result;
+    }
+    const LogIndex & index() const
+    {
+      return logIndex;
+    }
+
+  public slots:
+    void run();
+    void stop();
+
+  signals:
+    void started();
+    void progressStep(int percent);
+    void finished(bool success);
+
+  protected:
+    bool isStopRequested();
+    bool parseTimestamp(const char * date, int dateLen, const char * time, int timeLen, qint64 & timestamp);
+    void saveIndex(const QByteArray & header);
+
+    QString filename;
+    qint64 start;
+    qint64 end;
+    LogData result;
+    LogIndex logIndex;
+    QMutex stopReqMutex;
+    bool stopping;
+    QByteArray lastDateHour;      // timestamps cache, the date and hour of the last record
+    qint64 lastDateHourMs;
+};
+
+#endif // _LOGSLOADER_H_
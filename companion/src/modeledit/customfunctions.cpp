@@ -421,8 +421,9 @@ void CustomFunctionsPanel::refreshCustomFunction(int i, bool modified)
       }
       else if (func==FuncLogs) {
         fswtchParam[i]->setDecimals(1);
-        fswtchParam[i]->setMinimum(0);
+        fswtchParam[i]->setMinimum(IS_ARM(getCurrentBoard()) ? -0.5 : 0);
         fswtchParam[i]->setMaximum(25.5);
+        fswtchParam[i]->setToolTip(IS_ARM(getCurrentBoard()) ? tr("Negative values record a fast binary log, every 20ms per -0.1") : "");
         fswtchParam[i]->setSingleStep(0.1);
         if (modified)
           cfn.param = fswtchParam[i]->value()*10.0;
@@ -147,6 +147,8 @@ class SimulatorInterface : public QObject
     virtual void setTrainerTimeout(uint16_t ms) = 0;
     virtual void sendTelemetry(const QByteArray data) = 0;
     virtual void setLuaStateReloadPermanentScripts() = 0;
+    virtual void setInputsRecording(bool enable) = 0;
+    virtual void setTelemetryReplay(const QString & path, int speed) = 0;
     virtual void addTracebackDevice(QIODevice * device) = 0;
     virtual void removeTracebackDevice(QIODevice * device) = 0;
 
@@ -65,8 +65,11 @@ TelemetrySimulator::TelemetrySimulator(QWidget * parent, SimulatorInterface * si
   connect(ui->stop, SIGNAL(clicked()), this, SLOT(onStop()));
   connect(ui->positionIndicator, SIGNAL(valueChanged(int)), this, SLOT(onPositionIndicatorChanged(int)));
   connect(ui->replayRate, SIGNAL(valueChanged(int)), this, SLOT(onReplayRateChanged(int)));
+  connect(ui->loadCaptureFile, SIGNAL(released()), this, SLOT(onLoadCaptureFile()));
+  connect(ui->replayCapture, SIGNAL(toggled(bool)), this, SLOT(onReplayCaptureToggled(bool)));
 
   connect(this, &TelemetrySimulator::telemetryDataChanged, simulator, &SimulatorInterface::sendTelemetry);
+  connect(this, &TelemetrySimulator::telemetryReplayChanged, simulator, &SimulatorInterface::setTelemetryReplay);
   connect(simulator, &SimulatorInterface::started, this, &TelemetrySimulator::onSimulatorStarted);
   connect(simulator, &SimulatorInterface::stopped, this, &TelemetrySimulator::onSimulatorStopped);
 }
@@ -88,6 +91,7 @@ void TelemetrySimulator::onSimulatorStarted()
 void TelemetrySimulator::onSimulatorStopped()
 {
   m_simuStarted = false;
+  ui->replayCapture->setChecked(false);
 }
 
 void TelemetrySimulator::onSimulateToggled(bool isChecked)
@@ -111,6 +115,34 @@ void TelemetrySimulator::onLoadLogFile()
   logPlayback->loadLogFile();
 }
 
+// Telemetry captures (LOGS/TELEMETRY-*.cap) are decoded by the radio itself
+void TelemetrySimulator::onLoadCaptureFile()
+{
+  QString fileName = QFileDialog::getOpenFileName(this, tr("Telemetry Capture"), g.logDir(), tr("Telemetry Captures (*.cap *.log *.txt)"));
+  if (fileName.isEmpty())
+    return;
+
+  g.logDir(QFileInfo(fileName).absolutePath());
+  ui->replayCapture->setChecked(false);
+  captureFile = fileName;
+  ui->captureFileLabel->setText(QFileInfo(fileName).fileName());
+  ui->replayCapture->setEnabled(true);
+}
+
+void TelemetrySimulator::onReplayCaptureToggled(bool isChecked)
+{
+  static const int captureSpeeds[] = { 1, 2, 5, 10, 0 };
+
+  ui->loadCaptureFile->setEnabled(!isChecked);
+  ui->captureSpeed->setEnabled(!isChecked);
+  if (isChecked && !captureFile.isEmpty()) {
+    emit telemetryReplayChanged(captureFile, captureSpeeds[ui->captureSpeed->currentIndex()]);
+  }
+  else {
+    emit telemetryReplayChanged(QString(), 0);
+  }
+}
+
 void TelemetrySimulator::onPlay()
 {
   if (logPlayback->isReady()) {
@@ -49,6 +49,7 @@ class TelemetrySimulator : public QWidget
   signals:
 
     void telemetryDataChanged(const QByteArray data);
+    void telemetryReplayChanged(const QString & path, int speed);
 
   protected slots:
 
@@ -67,6 +68,8 @@ class TelemetrySimulator : public QWidget
     void onStop();
     void onPositionIndicatorChanged(int value);
     void onReplayRateChanged(int value);
+    void onLoadCaptureFile();
+    void onReplayCaptureToggled(bool isChecked);
     void refreshSensorRatios();
     void generateTelemetryFrame();
 
@@ -79,6 +82,7 @@ class TelemetrySimulator : public QWidget
     bool m_simuStarted;
     bool m_telemEnable;
     bool m_logReplayEnable;
+    QString captureFile;
 
   // protected classes follow
 
@@ -723,6 +723,9 @@ int cliStackInfo(const char ** argv)
   serialPrint("[MENUS] %d available / %d", menusStack.available(), menusStack.size());
   serialPrint("[MIXER] %d available / %d", mixerStack.available(), mixerStack.size());
   serialPrint("[AUDIO] %d available / %d", audioStack.available(), audioStack.size());
+#if defined(SDCARD)
+  serialPrint("[LOGS] %d available / %d", logsStack.available(), logsStack.size());
+#endif
   serialPrint("[CLI] %d available / %d", cliStack.available(), cliStack.size());
   return 0;
 }
@@ -1100,6 +1103,110 @@ int cliDisplay(const char ** argv)
   return 0;
 }
 
+#if defined(DEBUG_LATENCY)
+int cliLatency(const char ** argv)
+{
+  int point;
+  if (!strcmp(argv[1], "reset")) {
+    resetLatencyHistograms();
+  }
+  else if (toInt(argv, 1, &point) > 0) {
+    if (point < 0 || point >= LATENCY_POINTS_COUNT) {
+      serialPrint("%s: Invalid argument \"%s\"", argv[0], argv[1]);
+      return -1;
+    }
+    LatencyHistogram & histogram = latencyHistograms[point];
+    serialPrint("%s histogram [<from>us: <count>]:", latencyPointNames[point]);
+    for (int i=0; i<LATENCY_BUCKETS; i++) {
+      if (histogram.getBucket(i)) {
+        serialPrint("%d: %d", i * LATENCY_BUCKET_WIDTH / 2, histogram.getBucket(i));
+      }
+    }
+  }
+  else {
+    serialPrint("Latency from ADC sampling:");
+    for (int n=0; n<LATENCY_POINTS_COUNT; n++) {
+      LatencyHistogram & histogram = latencyHistograms[n];
+      if (histogram.getCount()) {
+        serialPrint("%d %s: min=%dus p50=%dus p99=%dus max=%dus n=%d", n, latencyPointNames[n], histogram.getMin(),
+                    histogram.getPercentile(50), histogram.getPercentile(99), histogram.getMax(), histogram.getCount());
+      }
+      else {
+        serialPrint("%d %s: no samples", n, latencyPointNames[n]);
+      }
+    }
+  }
+  return 0;
+}
+#endif
+
+#if defined(INPUTS_RECORDER)
+int cliRecord(const char ** argv)
+{
+  if (!strcmp(argv[1], "start")) {
+    const char * error = recordStart();
+    if (error) {
+      serialPrint("%s: %s", argv[0], error);
+      return -1;
+    }
+  }
+  else if (!strcmp(argv[1], "stop")) {
+    recordStop();
+  }
+  else if (argv[1][0] != '\0') {
+    serialPrint("%s: Invalid argument \"%s\"", argv[0], argv[1]);
+    return -1;
+  }
+  serialPrint("Inputs record %s", isRecording() ? "running" : "stopped");
+  return 0;
+}
+#endif
+
+int cliTelemetry(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    telemetryLinkStatsReset();
+  }
+  else if (argv[1][0] != '\0') {
+    serialPrint("%s: Invalid argument \"%s\"", argv[0], argv[1]);
+    return -1;
+  }
+  serialPrint("protocol=%d module=%d", telemetryLinkStats.protocol, telemetryLinkStats.module);
+  serialPrint("frames=%d crcErrors=%d resyncs=%d overruns=%d", telemetryLinkStats.frames, telemetryLinkStats.crcErrors, telemetryLinkStats.resyncs, telemetryLinkStats.overruns);
+  serialPrint("decodeTime=%dus decodeTimeMax=%dus", telemetryLinkStats.decodeTime / 2, telemetryLinkStats.decodeTimeMax / 2);
+  for (int i=0; i<TELEMETRY_GAPS_COUNT; i++) {
+    if (i == TELEMETRY_GAPS_COUNT-1)
+      serialPrint("gaps >= %dms: %d", 1 << i, telemetryLinkStats.gaps[i]);
+    else
+      serialPrint("gaps < %dms: %d", 2 << i, telemetryLinkStats.gaps[i]);
+  }
+  return 0;
+}
+
+#if defined(SDCARD)
+void cliLogsStats(const char * name, const LogsStats & stats, uint32_t size)
+{
+  serialPrint("%s: buffer=%d bufferMax=%d", name, size, stats.bufferMax);
+  serialPrint("%s: records=%d overruns=%d", name, stats.records, stats.overruns);
+  serialPrint("%s: bytes=%d flushes=%d", name, stats.bytes, stats.flushes);
+  serialPrint("%s: flushTime=%dms flushTimeMax=%dms", name, stats.flushes ? 2 * stats.flushTimeSum / stats.flushes : 0, 2 * stats.flushTimeMax);
+}
+
+int cliLogs(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    logsStatsReset();
+  }
+  else if (argv[1][0] != '\0') {
+    serialPrint("%s: Invalid argument \"%s\"", argv[0], argv[1]);
+    return -1;
+  }
+  cliLogsStats("csv", logsStats, LOGS_BUFFER_SIZE);
+  cliLogsStats("fast", logsFastStats, LOGS_FAST_BUFFER_SIZE);
+  return 0;
+}
+#endif
+
 int cliDebugVars(const char ** argv)
 {
 #if defined(PCBHORUS)
@@ -1231,6 +1338,16 @@ const CliCommand cliCommands[] = {
 #if defined(JITTER_MEASURE)
   { "jitter", cliShowJitter, "" },
 #endif
+#if defined(DEBUG_LATENCY)
+  { "latency", cliLatency, "[reset | <point>]" },
+#endif
+#if defined(INPUTS_RECORDER)
+  { "record", cliRecord, "[start | stop]" },
+#endif
+  { "telemetry", cliTelemetry, "[reset]" },
+#if defined(SDCARD)
+  { "logs", cliLogs, "[reset]" },
+#endif
 #if defined(INTERNAL_GPS)
   { "gps", cliGps, "<baudrate>|$<command>|trace" },
 #endif
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _CRC_H_
+#define _CRC_H_
+
+#include <inttypes.h>
+#include <string.h>
+
+// Table driven CRCs (MSB first) shared by the protocols
+//
+// Crc<crc_t, table> is a CRC of the width of crc_t, defined by its table (the
+// CRC of each byte value) rather than by its polynomial, as the PXX one is not
+// a plain polynomial CRC. The radio uses the byte tables, in flash. The host
+// builds (simu, gtests, mixerbench) derive slice-by-8 tables from them on first
+// use and process the data by 64 bits words.
+//
+// The STM32 CRC unit only computes the CRC-32 (0x04C11DB7) of 32 bits words,
+// which none of the protocols uses.
+
+extern const uint8_t crc8tab[256];        // CRSF, x^8+x^7+x^6+x^4+x^2+1 (0xD5)
+extern const uint16_t crc16tab[256];      // CCITT, x^16+x^12+x^5+1 (0x1021)
+#if defined(CPUARM)
+extern const uint16_t crc16tabPxx[256];   // PXX, the reflected CCITT table used MSB first
+#endif
+
+#if defined(SIMU) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  #define CRC_SLICES                     8 // bytes per step, read as a little endian word
+#endif
+
+template <class crc_t, const crc_t * table>
+class Crc
+{
+  public:
+    static inline crc_t update(crc_t crc, uint8_t byte)
+    {
+      return (crc << 8) ^ table[((crc >> (8*sizeof(crc_t)-8)) ^ byte) & 0xFF];
+    }
+
+    static crc_t compute(const uint8_t * data, uint32_t len, crc_t crc=0)
+    {
+#if defined(CRC_SLICES)
+      const SliceTables & slices = sliceTables();
+      while (len >= CRC_SLICES) {
+        // the current CRC is xored into the first bytes, then each byte
+        // contributes its CRC shifted by the zero bytes which follow it
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        for (uint8_t i=0; i<sizeof(crc_t); i++) {
+          word ^= (uint64_t)(uint8_t)(crc >> (8*(sizeof(crc_t)-1-i))) << (8*i);
+        }
+        crc_t result = 0;
+        for (uint8_t i=0; i<CRC_SLICES; i++) {
+          result ^= slices.slice[CRC_SLICES-1-i][(word >> (8*i)) & 0xFF];
+        }
+        crc = result;
+        data += CRC_SLICES;
+        len -= CRC_SLICES;
+      }
+#endif
+      while (len--) {
+        crc = update(crc, *data++);
+      }
+      return crc;
+    }
+
+#if defined(CRC_SLICES)
+  protected:
+    struct SliceTables {
+      crc_t slice[CRC_SLICES][256]; // slice[n][i] = CRC of byte i followed by n zero bytes
+
+      SliceTables()
+      {
+        for (int i=0; i<256; i++) {
+          slice[0][i] = table[i];
+          for (int n=1; n<CRC_SLICES; n++) {
+            slice[n][i] = update(slice[n-1][i], 0);
+          }
+        }
+      }
+    };
+
+    static const SliceTables & sliceTables()
+    {
+      static const SliceTables slices;
+      return slices;
+    }
+#endif
+};
+
+typedef Crc<uint8_t, crc8tab> Crc8;
+typedef Crc<uint16_t, crc16tab> Crc16;
+#if defined(CPUARM)
+typedef Crc<uint16_t, crc16tabPxx> CrcPxx;
+#endif
+
+uint8_t crc8(const uint8_t * ptr, uint32_t len);
+uint16_t crc16(const uint8_t * ptr, uint32_t len);
+
+// S.Port checksum, the one's complement sum of the bytes (not a CRC), with the
+// end around carries folded at the end
+inline uint8_t sportChecksum(const uint8_t * data, uint32_t len)
+{
+  uint32_t sum = 0;
+  while (len--) {
+    sum += *data++;
+  }
+  while (sum > 0xFF) {
+    sum = (sum & 0xFF) + (sum >> 8);
+  }
+  return sum;
+}
+
+#endif // _CRC_H_
@@ -53,6 +53,14 @@ void loadCurves()
     curveEnd[i] = tmp;
 
   }
+
+  // the mixer is paused here, tables are filled now rather than on its next cycle
+  resetCurveLuts();
+  for (int i=0; i<MAX_CURVES; i++) {
+    invalidateCurveLut(i);
+  }
+  updateCurveLuts();
+
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired");
     const char * w = "check your curves, logic switches";
@@ -76,7 +84,8 @@ bool moveCurve(uint8_t index, int8_t shift)
   memmove(nextCrv+shift, nextCrv, 5*(MAX_CURVES-index-1)+curveEnd[MAX_CURVES-1]-curveEnd[index]);
   if (shift < 0) memclear(&g_model.points[MAX_CURVE_POINTS-1] + shift, -shift);
   while (index<MAX_CURVES) {
-    curveEnd[index++] += shift;
+    curveEnd[index] += shift;
+    invalidateCurveLut(index++);
   }
   
   storageDirty(EE_MODEL);
@@ -261,6 +270,90 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
   }
   return 0;
 }
+
+/* Smooth curves are sampled once into a lookup table of CURVE_LUT_POINTS
+   values, evaluating them then costs two loads and a linear interpolation.
+   Tables are taken from a pool, a smooth curve without a table falls back
+   to hermite_spline().
+   Any code changing a curve has to call invalidateCurveLut() afterwards. The
+   curve is then read with hermite_spline() until the mixer task refills its
+   table at the start of its next cycle, tables and slots are only written by
+   the mixer task (or while it is paused). */
+int16_t curveLut[MAX_CURVE_LUTS][CURVE_LUT_POINTS];
+int8_t curveLutSlot[MAX_CURVES];
+bool curveLutDirty[MAX_CURVES];
+bool curveLutsDirty = false;
+
+void resetCurveLuts()
+{
+  memset(curveLutSlot, -1, sizeof(curveLutSlot));
+}
+
+static int8_t allocateCurveLut()
+{
+  for (int slot=0; slot<MAX_CURVE_LUTS; slot++) {
+    bool used = false;
+    for (int i=0; i<MAX_CURVES; i++) {
+      if (curveLutSlot[i] == slot) {
+        used = true;
+        break;
+      }
+    }
+    if (!used) {
+      return slot;
+    }
+  }
+  return -1;
+}
+
+void invalidateCurveLut(uint8_t idx)
+{
+  curveLutDirty[idx] = true;
+  curveLutsDirty = true;
+}
+
+static void fillCurveLut(uint8_t idx, int16_t * lut)
+{
+  for (int i=0; i<CURVE_LUT_POINTS; i++) {
+    lut[i] = hermite_spline(-RESX + i*CURVE_LUT_STEP, idx);
+  }
+}
+
+void updateCurveLuts()
+{
+  if (!curveLutsDirty) {
+    return;
+  }
+
+  // the dirty flags are cleared first, an edit made while filling sets them again
+  curveLutsDirty = false;
+  for (int idx=0; idx<MAX_CURVES; idx++) {
+    if (curveLutDirty[idx]) {
+      curveLutDirty[idx] = false;
+      int8_t slot = curveLutSlot[idx];
+      curveLutSlot[idx] = -1;
+      if (g_model.curves[idx].smooth) {
+        if (slot < 0) {
+          slot = allocateCurveLut();
+        }
+        if (slot >= 0) {
+          fillCurveLut(idx, curveLut[slot]);
+          curveLutSlot[idx] = slot;
+        }
+      }
+    }
+  }
+}
+
+int applyCurveLut(int x, int8_t slot)
+{
+  const int16_t * lut = curveLut[slot];
+  x = limit<int>(0, x + RESX, 2*RESX);
+  int i = x / CURVE_LUT_STEP;
+  if (i == CURVE_LUT_POINTS-1)
+    return lut[i];
+  return lut[i] + ((lut[i+1] - lut[i]) * (x % CURVE_LUT_STEP)) / CURVE_LUT_STEP;
+}
 #endif
 
 int intpol(int x, uint8_t idx) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
@@ -370,8 +463,11 @@ int applyCustomCurve(int x, uint8_t idx)
     return 0;
 
   CurveInfo & crv = g_model.curves[idx];
-  if (crv.smooth)
-    return hermite_spline(x, idx);
+  if (crv.smooth) {
+    // the slot is read once, the mixer task may change it meanwhile
+    int8_t slot = curveLutSlot[idx];
+    return (slot >= 0 && !curveLutDirty[idx]) ? applyCurveLut(x, slot) : hermite_spline(x, idx);
+  }
   else
     return intpol(x, idx);
 }
@@ -257,6 +257,7 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
   ,"Mix getsw  "   // debugTimerGetSwitches,
   ,"Mix eval   "   // debugTimerEvalMixes,
   ,"Mix 10ms   "   // debugTimerMixes10ms,
+  ,"Mix fade   "   // debugTimerMixFade,
   ,"ADC read   "   // debugTimerAdcRead,
   ,"mix-pulses "   // debugTimerMixerCalcToUsage
   ,"mix-int.   "   // debugTimerMixerIterval
@@ -267,3 +268,72 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
 };
 
 #endif
+
+#if defined(DEBUG_LATENCY)
+
+void LatencyHistogram::reset()
+{
+  memclear(buckets, sizeof(buckets));
+  count = 0;
+  min = 0xFFFF;
+  max = 0;
+}
+
+void LatencyHistogram::add(uint16_t latency)
+{
+  uint16_t index = latency / LATENCY_BUCKET_WIDTH;
+  if (index >= LATENCY_BUCKETS)
+    index = LATENCY_BUCKETS - 1;
+
+  if (buckets[index] == 0xFFFF) {
+    // keep the distribution, drop half of the history
+    count = 0;
+    for (uint8_t i=0; i<LATENCY_BUCKETS; i++) {
+      buckets[i] /= 2;
+      count += buckets[i];
+    }
+  }
+
+  buckets[index]++;
+  count++;
+  if (latency < min) min = latency;
+  if (latency > max) max = latency;
+}
+
+uint32_t LatencyHistogram::getPercentile(uint8_t percent) const
+{
+  if (count == 0)
+    return 0;
+
+  uint32_t threshold = (count * percent + 99) / 100;
+  uint32_t sum = 0;
+  for (uint8_t i=0; i<LATENCY_BUCKETS; i++) {
+    sum += buckets[i];
+    if (sum >= threshold) {
+      // upper bound of the bucket, never above the max seen
+      uint32_t result = (i + 1) * LATENCY_BUCKET_WIDTH;
+      return (result > max ? max : result) / 2;
+    }
+  }
+  return getMax();
+}
+
+uint16_t latencySampleTime;
+LatencyHistogram latencyHistograms[LATENCY_POINTS_COUNT];
+
+const char * const latencyPointNames[LATENCY_POINTS_COUNT] = {
+   "ADC        "   // latencyAdc
+  ,"Mixer      "   // latencyMixer
+  ,"Outputs    "   // latencyOutputs
+  ,"Pulses     "   // latencyPulses
+  ,"DMA        "   // latencyDma
+};
+
+void resetLatencyHistograms()
+{
+  for (uint8_t i=0; i<LATENCY_POINTS_COUNT; i++) {
+    latencyHistograms[i].reset();
+  }
+}
+
+#endif
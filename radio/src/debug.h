@@ -392,6 +392,7 @@ enum DebugTimers {
   debugTimerGetSwitches,
   debugTimerEvalMixes,
   debugTimerMixes10ms,
+  debugTimerMixFade,
 
   debugTimerAdcRead,
 
@@ -423,5 +424,85 @@ extern const char * const debugTimerNames[DEBUG_TIMERS_COUNT];
 
 #endif //#if defined(DEBUG_TIMERS)
 
+#if defined(DEBUG_LATENCY) && defined(__cplusplus)
+
+// Stick to RF latency: each point of the pipeline is timed from the last ADC
+// sampling and accumulated in a fixed buckets histogram. The latencies are
+// 16 bits differences of the 2MHz timer, they wrap above 32.7ms, which the
+// ADC sampled at least every mixer period (20ms max) never reaches unless the
+// mixer task is stalled. The last bucket holds all the latencies from 31.75ms
+#define LATENCY_BUCKETS          128
+#define LATENCY_BUCKET_WIDTH     500   // 2MHz ticks (250us)
+
+class LatencyHistogram
+{
+  public:
+    LatencyHistogram() { reset(); }
+
+    void reset();
+    void add(uint16_t latency);  // 2MHz ticks
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMin() const { return min / 2; }  // us
+    uint32_t getMax() const { return max / 2; }  // us
+    uint32_t getPercentile(uint8_t percent) const;  // us
+    uint16_t getBucket(uint8_t index) const { return buckets[index]; }
+
+  protected:
+    uint16_t buckets[LATENCY_BUCKETS];
+    uint32_t count;
+    uint16_t min;
+    uint16_t max;
+};
+
+enum LatencyPoints {
+  latencyAdc,       // getADC() done
+  latencyMixer,     // mixer lines done
+  latencyOutputs,   // channelOutputs published
+  latencyPulses,    // setupPulses() done, at frame start
+  latencyDma,       // frame transfer started
+  LATENCY_POINTS_COUNT
+};
+
+extern uint16_t latencySampleTime;
+extern LatencyHistogram latencyHistograms[LATENCY_POINTS_COUNT];
+extern const char * const latencyPointNames[LATENCY_POINTS_COUNT];
+void resetLatencyHistograms();
+
+#define LATENCY_SAMPLE()          latencySampleTime = getTmr2MHz()
+#define LATENCY_MEASURE(point)    latencyHistograms[point].add(getTmr2MHz() - latencySampleTime)
+
+#else
+
+#define LATENCY_SAMPLE()
+#define LATENCY_MEASURE(point)
+
+#endif // #if defined(DEBUG_LATENCY)
+
+#if defined(MIXER_BENCHMARK) && defined(__cplusplus)
+
+// Host side mixer benchmark (tests/benchmark): time spent in each mixer stage
+enum BenchmarkStages {
+  benchmarkStageInputs,
+  benchmarkStageLogicalSwitches,
+  benchmarkStageFunctions,
+  benchmarkStageLimits,
+  BENCHMARK_STAGES_COUNT
+};
+
+extern uint64_t benchmarkStageStart[BENCHMARK_STAGES_COUNT];
+extern uint64_t benchmarkStageTime[BENCHMARK_STAGES_COUNT];  // ns
+uint64_t benchmarkGetNanos();
+
+#define BENCHMARK_STAGE_START(stage)   benchmarkStageStart[stage] = benchmarkGetNanos()
+#define BENCHMARK_STAGE_STOP(stage)    benchmarkStageTime[stage] += benchmarkGetNanos() - benchmarkStageStart[stage]
+
+#else
+
+#define BENCHMARK_STAGE_START(stage)
+#define BENCHMARK_STAGE_STOP(stage)
+
+#endif // #if defined(MIXER_BENCHMARK)
+
 #endif // _DEBUG_H_
 
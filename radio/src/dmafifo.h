@@ -68,6 +68,25 @@ class DMAFifo
       }
     }
 
+    // Bytes which can be read in place, up to the DMA write index or the end of
+    // the buffer. They are removed from the fifo with skip() once processed
+    uint32_t getContiguousData(const uint8_t * & data)
+    {
+#if defined(SIMU)
+      // no DMA in the simulator, the telemetry replay calls the chunk parser
+      return 0;
+#else
+      uint32_t widx = (N - stream->NDTR) & (N-1);
+      data = &fifo[ridx];
+      return (widx >= ridx ? widx : N) - ridx;
+#endif
+    }
+
+    void skip(uint32_t count)
+    {
+      ridx = (ridx+count) & (N-1);
+    }
+
     uint8_t * buffer()
     {
       return fifo;
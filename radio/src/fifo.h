@@ -47,6 +47,17 @@ class Fifo
       }
     }
 
+    // Pushes all the elements at once, the caller checks hasSpace() first
+    void push(const T * elements, uint32_t count)
+    {
+      uint32_t next = widx;
+      for (uint32_t i=0; i<count; i++) {
+        fifo[next] = elements[i];
+        next = (next+1) & (N-1);
+      }
+      widx = next;
+    }
+
     bool pop(T & element)
     {
       if (isEmpty()) {
@@ -96,6 +107,20 @@ class Fifo
       }
     }
 
+    // Elements which can be read in place, up to the write index or the end of
+    // the buffer. They are removed from the fifo with skip() once processed
+    uint32_t getContiguousData(const T * & data) const
+    {
+      uint32_t w = widx;
+      data = &fifo[ridx];
+      return (w >= ridx ? w : N) - ridx;
+    }
+
+    void skip(uint32_t count)
+    {
+      ridx = (ridx+count) & (N-1);
+    }
+
   protected:
     T fifo[N];
     volatile uint32_t widx;
@@ -558,10 +558,16 @@ void evalFunctions()
 
 #if defined(SDCARD)
           case FUNC_LOGS:
-            if (CFN_PARAM(cfn)) {
+            if (CFN_PARAM(cfn) > 0) {
               newActiveFunctions |= (1 << FUNCTION_LOGS);
               logDelay = CFN_PARAM(cfn);
             }
+#if defined(CPUARM)
+            else if (CFN_PARAM(cfn) < 0) {
+              newActiveFunctions |= (1 << FUNCTION_LOGS_FAST);
+              logsFastPeriod = -CFN_PARAM(cfn);
+            }
+#endif
             break;
 #endif
 
@@ -37,96 +37,92 @@
  */
 
 #include "opentx.h"
-#include <ctype.h>
 
 gpsdata_t gpsData;
 
 /* This is a light implementation of a GPS frame decoding
-   This should work with most of modern GPS devices configured to output 5 frames.
-   It assumes there are some NMEA GGA frames to decode on the serial bus
-   Now verifies checksum correctly before applying data
+   This should work with most of modern GPS devices configured to output NMEA frames.
+   The frames are decoded in a single pass as the characters are received: the
+   numeric fields are converted and the checksum is computed on the fly, the
+   data is applied only once the checksum has been verified.
 
    Here we use only the following data :
-     - latitude
-     - longitude
-     - GPS fix is/is not ok
-     - GPS num sat (4 is enough to be +/- reliable)
-     // added by Mis
-     - GPS altitude (for OSD displaying)
-     - GPS speed (for OSD displaying)
+     - latitude, longitude, altitude, GPS fix, num sat (GGA)
+     - speed, ground course, date and time (RMC)
+     - speed, ground course (VTG)
+     - HDOP (GGA, GSA)
+
+   The other sentences are turned off (u-blox PUBX command).
 */
 
-#define NO_FRAME   0
-#define FRAME_GGA  1
-#define FRAME_RMC  2
+enum NmeaState {
+  NMEA_STATE_IDLE,      // waiting for '$'
+  NMEA_STATE_FIELD,     // inside a field
+  NMEA_STATE_CHECKSUM,  // after '*'
+};
 
-#define DIGIT_TO_VAL(_x)    (_x - '0')
+enum NmeaFieldType {
+  NMEA_FIELD_SKIP,
+  NMEA_FIELD_TIME,
+  NMEA_FIELD_LATITUDE,
+  NMEA_FIELD_NORTH_SOUTH,
+  NMEA_FIELD_LONGITUDE,
+  NMEA_FIELD_EAST_WEST,
+  NMEA_FIELD_QUALITY,       // GGA fix quality, 0 = no fix
+  NMEA_FIELD_STATUS,        // RMC status, 'A' = valid
+  NMEA_FIELD_SATELLITES,
+  NMEA_FIELD_HDOP,
+  NMEA_FIELD_ALTITUDE,
+  NMEA_FIELD_SPEED_KNOTS,
+  NMEA_FIELD_COURSE,
+  NMEA_FIELD_DATE,
+};
 
-uint32_t GPS_coord_to_degrees(const char * coordinateString)
-{
-  const char * fieldSeparator, * remainingString;
-  uint8_t degrees = 0, minutes = 0;
-  uint16_t fractionalMinutes = 0;
-  uint8_t digitIndex;
-
-  // scan for decimal point or end of field
-  for (fieldSeparator = coordinateString; isdigit((unsigned char) *fieldSeparator); fieldSeparator++) {
-    if (fieldSeparator >= coordinateString + 15)
-      return 0; // stop potential fail
-  }
-  remainingString = coordinateString;
+enum NmeaSentenceType {
+  NMEA_GGA,
+  NMEA_RMC,
+  NMEA_VTG,
+  NMEA_GSA,
+  NMEA_UNKNOWN
+};
 
-  // convert degrees
-  while ((fieldSeparator - remainingString) > 2) {
-    if (degrees)
-      degrees *= 10;
-    degrees += DIGIT_TO_VAL(*remainingString++);
-  }
-  // convert minutes
-  while (fieldSeparator > remainingString) {
-    if (minutes)
-      minutes *= 10;
-    minutes += DIGIT_TO_VAL(*remainingString++);
-  }
-  // convert fractional minutes
-  // expect up to four digits, result is in
-  // ten-thousandths of a minute
-  if (*fieldSeparator == '.') {
-    remainingString = fieldSeparator + 1;
-    for (digitIndex = 0; digitIndex < 4; digitIndex++) {
-      fractionalMinutes *= 10;
-      if (isdigit((unsigned char) *remainingString))
-        fractionalMinutes += *remainingString++ - '0';
-    }
-  }
-  // TODO return degrees * 10000000UL + (minutes * 1000000UL + fractionalMinutes * 100UL) / 6;
-  return degrees * 1000000UL + (minutes * 100000UL + fractionalMinutes * 10UL) / 6;
-}
+#define NMEA_MAX_FIELDS          17
+#define NMEA_MAX_DECIMALS        4  // of the coordinates minutes
 
-// helper functions
-uint32_t grab_fields(char * src, uint8_t mult)
-{
-  uint32_t i;
-  uint32_t tmp = 0;
-  for (i = 0; src[i] != 0; i++) {
-    if (src[i] == '.') {
-      i++;
-      if (mult == 0)
-        break;
-      else
-        src[i + mult] = 0;
-    }
-    tmp *= 10;
-    if (src[i] >= '0' && src[i] <= '9')
-      tmp += src[i] - '0';
-    if (i >= 15)
-      return 0; // out of bounds
-  }
-  return tmp;
-}
+struct NmeaSentence {
+  char id[3];
+  uint8_t fields[NMEA_MAX_FIELDS];   // NmeaFieldType of each field, the address field first
+};
 
-typedef struct gpsDataNmea_s
-{
+static const NmeaSentence nmeaSentences[] = {
+  // $GPGGA,hhmmss.ss,llll.ll,a,yyyyy.yy,a,x,xx,x.x,x.x,M,x.x,M,x.x,xxxx*hh
+  { {'G', 'G', 'A'}, { NMEA_FIELD_SKIP, NMEA_FIELD_TIME, NMEA_FIELD_LATITUDE, NMEA_FIELD_NORTH_SOUTH, NMEA_FIELD_LONGITUDE, NMEA_FIELD_EAST_WEST,
+                       NMEA_FIELD_QUALITY, NMEA_FIELD_SATELLITES, NMEA_FIELD_HDOP, NMEA_FIELD_ALTITUDE } },
+  // $GPRMC,hhmmss.ss,A,llll.ll,a,yyyyy.yy,a,x.x,x.x,ddmmyy,x.x,a*hh
+  { {'R', 'M', 'C'}, { NMEA_FIELD_SKIP, NMEA_FIELD_TIME, NMEA_FIELD_STATUS, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP,
+                       NMEA_FIELD_SPEED_KNOTS, NMEA_FIELD_COURSE, NMEA_FIELD_DATE } },
+  // $GPVTG,x.x,T,x.x,M,x.x,N,x.x,K*hh
+  { {'V', 'T', 'G'}, { NMEA_FIELD_SKIP, NMEA_FIELD_COURSE, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SPEED_KNOTS } },
+  // $GPGSA,a,x,xx,xx,xx,xx,xx,xx,xx,xx,xx,xx,xx,xx,x.x,x.x,x.x*hh
+  { {'G', 'S', 'A'}, { NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP,
+                       NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_SKIP,
+                       NMEA_FIELD_SKIP, NMEA_FIELD_SKIP, NMEA_FIELD_HDOP } },
+};
+
+struct NmeaParser {
+  uint8_t state;
+  uint8_t sentence;
+  uint8_t field;
+  uint8_t parity;
+  uint8_t checksum;
+  uint8_t length;           // letters in the current field, or checksum digits
+  char letters[5];          // talker + sentence id, N/S/E/W/A/V indicators
+  uint8_t point;            // 1 once the decimal point has been received
+  uint8_t decimals;         // digits after the decimal point
+  uint32_t value;           // all the digits of the field, up to 9
+};
+
+struct NmeaData {
   uint8_t fix;
   int32_t latitude;
   int32_t longitude;
@@ -134,191 +130,311 @@ typedef struct gpsDataNmea_s
   uint16_t altitude;
   uint16_t speed;
   uint16_t groundCourse;
+  uint16_t hdop;
   uint32_t date;
   uint32_t time;
-} gpsDataNmea_t;
+};
 
-bool gpsNewFrameNMEA(char c)
+static NmeaParser nmeaParser;
+static NmeaData nmeaData;
+
+// value of the current field with <decimals> digits after the decimal point
+static uint32_t nmeaFieldValue(uint8_t decimals)
 {
-  static gpsDataNmea_t gps_Msg;
-
-  uint8_t frameOK = 0;
-  static uint8_t param = 0, offset = 0, parity = 0;
-  static char string[15];
-  static uint8_t checksum_param, gps_frame = NO_FRAME;
-
-  switch (c) {
-    case '$':
-      param = 0;
-      offset = 0;
-      parity = 0;
-      break;
-    case ',':
-    case '*':
-      string[offset] = 0;
-      if (param == 0) {
-        // Frame identification (accept all GPS talkers (GP: GPS, GL:Glonass, GN:combination, etc...))
-        gps_frame = NO_FRAME;
-        if (string[0] == 'G' && string[2] == 'G' && string[3] == 'G' && string[4] == 'A') {
-          gps_frame = FRAME_GGA;
-        }
-        else if (string[0] == 'G' && string[2] == 'R' && string[3] == 'M' && string[4] == 'C') {
-          gps_frame = FRAME_RMC;
-        }
-        else {
-          // turn off this frame (do this only once a second)
-          static gtime_t lastGpsCmdSent = 0;
-          if (string[0] == 'G' && g_rtcTime != lastGpsCmdSent) {
-            lastGpsCmdSent = g_rtcTime;
-            char cmd[] = "$PUBX,40,GSV,0,0,0,0";
-            cmd[9]  = string[2];
-            cmd[10] = string[3];
-            cmd[11] = string[4];
-            gpsSendFrame(cmd);
-          }
-        }
-      }
+  uint32_t result = nmeaParser.value;
+  for (uint8_t count = nmeaParser.decimals; count > decimals; count--) {
+    result /= 10;
+  }
+  for (uint8_t count = nmeaParser.decimals; count < decimals; count++) {
+    result *= 10;
+  }
+  return result;
+}
 
-      switch (gps_frame) {
-        case FRAME_GGA:        //************* GPGGA FRAME parsing
-          switch (param) {
-            case 2:
-              gps_Msg.latitude = GPS_coord_to_degrees(string);
-              break;
-            case 3:
-              if (string[0] == 'S')
-                gps_Msg.latitude *= -1;
-              break;
-            case 4:
-              gps_Msg.longitude = GPS_coord_to_degrees(string);
-              break;
-            case 5:
-              if (string[0] == 'W')
-                gps_Msg.longitude *= -1;
-              break;
-            case 6:
-              if (string[0] > '0') {
-                gps_Msg.fix = 1;
-              }
-              else {
-                gps_Msg.fix = 0;
-              }
-              break;
-            case 7:
-              gps_Msg.numSat = grab_fields(string, 0);
-              break;
-            case 9:
-              gps_Msg.altitude = grab_fields(string, 0);     // altitude in meters added by Mis
-              break;
-          }
-          break;
-        case FRAME_RMC:        //************* GPRMC FRAME parsing
-          switch (param) {
-            case 1:
-              gps_Msg.time = grab_fields(string, 0);
-              break;
-            case 2:
-              if (string[0] == 'A') {
-                gps_Msg.fix = 1;
-              }
-              else {
-                gps_Msg.fix = 0;
-              }
-              break;
-            case 7:
-              gps_Msg.speed = ((grab_fields(string, 1) * 5144L) / 1000L);    // speed in cm/s added by Mis
-              break;
-            case 8:
-              gps_Msg.groundCourse = (grab_fields(string, 1));      // ground course deg * 10
-              break;
-            case 9:
-              gps_Msg.date = grab_fields(string, 0);
-              break;
-          }
-          break;
+// ddmm.mmmm or dddmm.mmmm to degrees * 1.000.000
+static int32_t nmeaFieldCoordinates()
+{
+  uint32_t value = nmeaFieldValue(NMEA_MAX_DECIMALS);
+  uint32_t degrees = value / 1000000;
+  uint32_t minutes = value - degrees * 1000000;
+  return degrees * 1000000UL + minutes * 10UL / 6;
+}
+
+static void nmeaStartSentence()
+{
+  nmeaParser.state = NMEA_STATE_FIELD;
+  nmeaParser.sentence = NMEA_UNKNOWN;
+  nmeaParser.field = 0;
+  nmeaParser.parity = 0;
+  nmeaParser.checksum = 0;
+}
+
+static void nmeaStartField()
+{
+  nmeaParser.length = 0;
+  nmeaParser.letters[0] = 0;
+  nmeaParser.point = 0;
+  nmeaParser.decimals = 0;
+  nmeaParser.value = 0;
+}
 
+static void nmeaIdentifySentence()
+{
+  // accept all GPS talkers (GP: GPS, GL:Glonass, GN:combination, etc...)
+  if (nmeaParser.length == 5 && nmeaParser.letters[0] == 'G') {
+    for (uint8_t i=0; i<DIM(nmeaSentences); i++) {
+      if (!memcmp(&nmeaParser.letters[2], nmeaSentences[i].id, 3)) {
+        nmeaParser.sentence = i;
+        return;
       }
+    }
+
+    // turn off this frame (do this only once a second)
+    static gtime_t lastGpsCmdSent = 0;
+    if (g_rtcTime != lastGpsCmdSent) {
+      lastGpsCmdSent = g_rtcTime;
+      char cmd[] = "$PUBX,40,GSV,0,0,0,0";
+      cmd[9]  = nmeaParser.letters[2];
+      cmd[10] = nmeaParser.letters[3];
+      cmd[11] = nmeaParser.letters[4];
+      gpsSendFrame(cmd);
+    }
+  }
+}
+
+static NOINLINE void nmeaEndField()
+{
+  if (nmeaParser.field == 0) {
+    nmeaIdentifySentence();
+    return;
+  }
 
-      param++;
-      offset = 0;
-      if (c == '*')
-        checksum_param = 1;
-      else
-        parity ^= c;
+  if (nmeaParser.sentence == NMEA_UNKNOWN || nmeaParser.field >= NMEA_MAX_FIELDS)
+    return;
+
+  switch (nmeaSentences[nmeaParser.sentence].fields[nmeaParser.field]) {
+    case NMEA_FIELD_TIME:
+      nmeaData.time = nmeaFieldValue(0);
+      break;
+    case NMEA_FIELD_LATITUDE:
+      nmeaData.latitude = nmeaFieldCoordinates();
+      break;
+    case NMEA_FIELD_NORTH_SOUTH:
+      if (nmeaParser.letters[0] == 'S')
+        nmeaData.latitude = -nmeaData.latitude;
+      break;
+    case NMEA_FIELD_LONGITUDE:
+      nmeaData.longitude = nmeaFieldCoordinates();
+      break;
+    case NMEA_FIELD_EAST_WEST:
+      if (nmeaParser.letters[0] == 'W')
+        nmeaData.longitude = -nmeaData.longitude;
+      break;
+    case NMEA_FIELD_QUALITY:
+      nmeaData.fix = (nmeaParser.value > 0);
       break;
-    case '\r':
-    case '\n':
-      if (checksum_param) {   //parity checksum
-        uint8_t checksum = 16 * ((string[0] >= 'A') ? string[0] - 'A' + 10 : string[0] - '0') +
-                           ((string[1] >= 'A') ? string[1] - 'A' + 10 : string[1] - '0');
-        if (checksum == parity) {
-          gpsData.packetCount++;
-          switch (gps_frame) {
-            case FRAME_GGA:
-              frameOK = 1;
-              gpsData.fix = gps_Msg.fix;
-              gpsData.numSat = gps_Msg.numSat;
-              if (gps_Msg.fix) {
-                __disable_irq();    // do the atomic update of lat/lon
-                gpsData.latitude = gps_Msg.latitude;
-                gpsData.longitude = gps_Msg.longitude;
-                gpsData.altitude = gps_Msg.altitude;
-                __enable_irq();
-              }
-              break;
-            case FRAME_RMC:
-              gpsData.speed = gps_Msg.speed;
-              gpsData.groundCourse = gps_Msg.groundCourse;
+    case NMEA_FIELD_STATUS:
+      nmeaData.fix = (nmeaParser.letters[0] == 'A');
+      break;
+    case NMEA_FIELD_SATELLITES:
+      nmeaData.numSat = nmeaFieldValue(0);
+      break;
+    case NMEA_FIELD_HDOP:
+      nmeaData.hdop = nmeaFieldValue(2);
+      break;
+    case NMEA_FIELD_ALTITUDE:
+      nmeaData.altitude = nmeaFieldValue(0);   // altitude in meters added by Mis
+      break;
+    case NMEA_FIELD_SPEED_KNOTS:
+      nmeaData.speed = nmeaFieldValue(1) * 5144L / 1000L;
+      break;
+    case NMEA_FIELD_COURSE:
+      nmeaData.groundCourse = nmeaFieldValue(1);
+      break;
+    case NMEA_FIELD_DATE:
+      nmeaData.date = nmeaFieldValue(0);
+      break;
+  }
+}
+
+static NOINLINE bool nmeaEndSentence()
+{
+  gpsData.packetCount++;
+
+  switch (nmeaParser.sentence) {
+    case NMEA_GGA:
+      gpsData.fix = nmeaData.fix;
+      gpsData.numSat = nmeaData.numSat;
+      gpsData.hdop = nmeaData.hdop;
+      if (nmeaData.fix) {
+        __disable_irq();    // do the atomic update of lat/lon
+        gpsData.latitude = nmeaData.latitude;
+        gpsData.longitude = nmeaData.longitude;
+        gpsData.altitude = nmeaData.altitude;
+        __enable_irq();
+      }
+      return true;
+
+    case NMEA_RMC:
+      gpsData.speed = nmeaData.speed;
+      gpsData.groundCourse = nmeaData.groundCourse;
 #if defined(RTCLOCK)
-              // set RTC clock if needed
-              if (g_eeGeneral.adjustRTC && gps_Msg.fix) {
-                div_t qr = div(gps_Msg.date, 100);
-                uint8_t year = qr.rem;
-                qr = div(qr.quot, 100);
-                uint8_t mon = qr.rem;
-                uint8_t day = qr.quot;
-                qr = div(gps_Msg.time, 100);
-                uint8_t sec = qr.rem;
-                qr = div(qr.quot, 100);
-                uint8_t min = qr.rem;
-                uint8_t hour = qr.quot;
-                rtcAdjust(year+2000, mon, day, hour, min, sec);
-              }
-#endif
-          } // end switch
-        }
-        else {
-          gpsData.errorCount++;
-        }
+      // set RTC clock if needed
+      if (g_eeGeneral.adjustRTC && nmeaData.fix) {
+        div_t qr = div(nmeaData.date, 100);
+        uint8_t year = qr.rem;
+        qr = div(qr.quot, 100);
+        uint8_t mon = qr.rem;
+        uint8_t day = qr.quot;
+        qr = div(nmeaData.time, 100);
+        uint8_t sec = qr.rem;
+        qr = div(qr.quot, 100);
+        uint8_t min = qr.rem;
+        uint8_t hour = qr.quot;
+        rtcAdjust(year+2000, mon, day, hour, min, sec);
       }
-      checksum_param = 0;
+#endif
+      break;
+
+    case NMEA_VTG:
+      gpsData.speed = nmeaData.speed;
+      gpsData.groundCourse = nmeaData.groundCourse;
+      break;
+
+    case NMEA_GSA:
+      gpsData.hdop = nmeaData.hdop;
       break;
-    default:
-      if (offset < 15)
-        string[offset++] = c;
-      if (!checksum_param)
-        parity ^= c;
   }
-  return frameOK;
+
+  return false;
 }
 
-bool gpsNewFrame(uint8_t c)
+static uint8_t nmeaHexDigit(uint8_t c)
 {
-  return gpsNewFrameNMEA(c);
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  else if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  else if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  else
+    return 0xFF;
 }
 
-void gpsNewData(uint8_t c)
+// Returns true when a position (GGA) has been received
+bool gpsNewFrameNMEA(const uint8_t * data, uint32_t count)
 {
-  if (!gpsNewFrame(c)) {
-    return;
+  bool result = false;
+  const uint8_t * end = data + count;
+
+  while (data < end) {
+    uint8_t c = *data++;
+
+    if (c == '$') {
+      nmeaStartSentence();
+      nmeaStartField();
+      continue;
+    }
+
+    switch (nmeaParser.state) {
+      case NMEA_STATE_FIELD:
+      {
+        // the field characters, with the parser state kept in registers
+        uint8_t parity = nmeaParser.parity;
+        uint32_t value = nmeaParser.value;
+        uint8_t decimals = nmeaParser.decimals;
+        uint8_t point = nmeaParser.point;
+        bool separator = false;
+        while (true) {
+          if (c == ',' || c == '*' || c == '\r' || c == '\n' || c == '$') {
+            separator = true;
+            break;
+          }
+          parity ^= c;
+          uint8_t digit = c - '0';
+          if (digit <= 9) {
+            if (value < 100000000) {
+              value = value * 10 + digit;
+              decimals += point;
+            }
+          }
+          else if (c == '.') {
+            point = 1;
+          }
+          else if (nmeaParser.length < sizeof(nmeaParser.letters)) {
+            nmeaParser.letters[nmeaParser.length++] = c;
+          }
+          if (data == end)
+            break;
+          c = *data++;
+        }
+        nmeaParser.parity = parity;
+        nmeaParser.value = value;
+        nmeaParser.decimals = decimals;
+        nmeaParser.point = point;
+
+        if (!separator) {
+          // the field continues in the next chunk
+          break;
+        }
+
+        if (c == '$') {
+          data--;
+        }
+        else if (c == ',' || c == '*') {
+          nmeaEndField();
+          nmeaParser.field++;
+          nmeaStartField();
+          if (c == '*')
+            nmeaParser.state = NMEA_STATE_CHECKSUM;
+          else
+            nmeaParser.parity ^= c;
+        }
+        else {
+          // no checksum, the sentence is ignored
+          nmeaParser.state = NMEA_STATE_IDLE;
+        }
+        break;
+      }
+
+      case NMEA_STATE_CHECKSUM:
+        if (c == '\r' || c == '\n') {
+          nmeaParser.state = NMEA_STATE_IDLE;
+          if (nmeaParser.length == 2 && nmeaParser.checksum == nmeaParser.parity) {
+            result |= nmeaEndSentence();
+          }
+          else {
+            gpsData.errorCount++;
+          }
+        }
+        else {
+          uint8_t digit = nmeaHexDigit(c);
+          if (digit == 0xFF || nmeaParser.length == 2) {
+            // not a checksum
+            nmeaParser.state = NMEA_STATE_IDLE;
+            gpsData.errorCount++;
+          }
+          else {
+            nmeaParser.checksum = (nmeaParser.checksum << 4) + digit;
+            nmeaParser.length++;
+          }
+        }
+        break;
+    }
   }
+
+  return result;
 }
 
 void gpsWakeup()
 {
-  uint8_t byte;
-  while (gpsGetByte(&byte)) {
-    gpsNewData(byte);
+  const uint8_t * data;
+  uint32_t count = gpsGetData(&data);
+  while (count > 0) {
+    gpsNewFrameNMEA(data, count);
+    gpsSkipData(count);
+    // a second chunk when the data wraps at the end of the fifo
+    count = gpsGetData(&data);
   }
 }
 
@@ -35,10 +35,12 @@ struct gpsdata_t
   uint16_t altitude;              // altitude in 0.1m
   uint16_t speed;                 // speed in 0.1m/s
   uint16_t groundCourse;          // degrees * 10
+  uint16_t hdop;                  // hdop * 100
 };
 
 extern gpsdata_t gpsData;
 void gpsWakeup();
+bool gpsNewFrameNMEA(const uint8_t * data, uint32_t count);
 
 void gpsSendFrame(const char * frame);
 
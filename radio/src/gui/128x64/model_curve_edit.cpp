@@ -39,6 +39,7 @@ void displayPresetChoice(event_t event)
     if (crv.type == CURVE_TYPE_CUSTOM) {
       resetCustomCurveX(points, 5+crv.points);
     }
+    invalidateCurveLut(s_curveChan);
   }
 }
 
@@ -52,6 +53,7 @@ void onCurveOneMenu(const char * result)
     int8_t * points = curveAddress(s_curveChan);
     for (int i=0; i<5+crv.points; i++)
       points[i] = -points[i];
+    invalidateCurveLut(s_curveChan);
   }
   else if (result == STR_CLEAR) {
     CurveInfo & crv = g_model.curves[s_curveChan];
@@ -61,6 +63,7 @@ void onCurveOneMenu(const char * result)
     if (crv.type == CURVE_TYPE_CUSTOM) {
       resetCustomCurveX(points, 5+crv.points);
     }
+    invalidateCurveLut(s_curveChan);
   }
 }
 
@@ -123,7 +126,12 @@ void menuModelCurveOne(event_t event)
   // Curve smooth
   lcdDrawTextAlignedLeft(7*FH+1, STR_SMOOTH);
   drawCheckBox(7 * FW, 7 * FH + 1, crv.smooth, menuVerticalPosition == 3 ? INVERS : 0);
-  if (menuVerticalPosition==3) crv.smooth = checkIncDecModel(event, crv.smooth, 0, 1);
+  if (menuVerticalPosition==3) {
+    crv.smooth = checkIncDecModel(event, crv.smooth, 0, 1);
+    if (checkIncDec_Ret) {
+      invalidateCurveLut(s_curveChan);
+    }
+  }
 
   switch (event) {
     case EVT_ENTRY:
@@ -180,6 +188,9 @@ void menuModelCurveOne(event_t event)
           CHECK_INCDEC_MODELVAR(event, points[5+crv.points+i-1], i==1 ? -100 : points[5+crv.points+i-2], i==5+crv.points-2 ? 100 : points[5+crv.points+i]);  // edit X
         else if (selectionMode == 2)
           CHECK_INCDEC_MODELVAR(event, points[i], -100, 100);
+        if (checkIncDec_Ret) {
+          invalidateCurveLut(s_curveChan);
+        }
       }
     }
   }
@@ -414,6 +414,15 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
 #endif  // CPUARM
 #if defined(SDCARD)
           else if (func == FUNC_LOGS) {
+#if defined(CPUARM)
+            val_min = -LOGS_FAST_PERIOD_MAX;
+            if (val_displayed < 0) {
+              // fast (binary) logs
+              lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, -val_displayed * LOGS_FAST_PERIOD_TICKS * 2, attr|LEFT);
+              lcdDrawText(lcdLastRightPos, y, "ms");
+            }
+            else
+#endif
             if (val_displayed) {
               lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, val_displayed, attr|PREC1|LEFT);
               lcdDrawChar(lcdLastRightPos, y, 's');
@@ -275,7 +275,7 @@ void displayTopBar()
     x -= 12;
   }
 
-  if (isFunctionActive(FUNCTION_LOGS)) {
+  if (isFunctionActive(FUNCTION_LOGS) || isFunctionActive(FUNCTION_LOGS_FAST)) {
     LCD_NOTIF_ICON(x, ICON_LOGS);
     x -= 12;
   }
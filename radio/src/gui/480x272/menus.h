@@ -151,6 +151,7 @@ const uint8_t STATS_ICONS[] = {
   ICON_STATS_THROTTLE_GRAPH,
   ICON_STATS_DEBUG,
   ICON_STATS_ANALOGS,
+  ICON_MODEL_TELEMETRY,
 #if defined(DEBUG_TRACE_BUFFER)
   ICON_STATS_TIMERS
 #endif
@@ -208,6 +209,7 @@ enum MenuRadioIndexes
   e_StatsGraph,
   e_StatsDebug,
   e_StatsAnalogs,
+  e_StatsTelemetry,
 #if defined(DEBUG_TRACE_BUFFER)
   e_StatsTraces,
 #endif
@@ -216,12 +218,14 @@ enum MenuRadioIndexes
 bool menuStatsGraph(event_t event);
 bool menuStatsDebug(event_t event);
 bool menuStatsAnalogs(event_t event);
+bool menuStatsTelemetry(event_t event);
 bool menuStatsTraces(event_t event);
 
 static const MenuHandlerFunc menuTabStats[] PROGMEM = {
   menuStatsGraph,
   menuStatsDebug,
   menuStatsAnalogs,
+  menuStatsTelemetry,
 #if defined(DEBUG_TRACE_BUFFER)
   menuStatsTraces,
 #endif
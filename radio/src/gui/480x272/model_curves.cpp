@@ -43,6 +43,7 @@ void displayPresetChoice(event_t event)
     if (crv.type == CURVE_TYPE_CUSTOM) {
       resetCustomCurveX(points, 5+crv.points);
     }
+    invalidateCurveLut(s_curveChan);
   }
 }
 
@@ -56,6 +57,7 @@ void onCurveOneMenu(const char * result)
     int8_t * points = curveAddress(s_curveChan);
     for (int i=0; i<5+crv.points; i++)
       points[i] = -points[i];
+    invalidateCurveLut(s_curveChan);
   }
   else if (result == STR_CLEAR) {
     CurveInfo & crv = g_model.curves[s_curveChan];
@@ -65,6 +67,7 @@ void onCurveOneMenu(const char * result)
     if (crv.type == CURVE_TYPE_CUSTOM) {
       resetCustomCurveX(points, 5+crv.points);
     }
+    invalidateCurveLut(s_curveChan);
   }
 }
 
@@ -155,7 +158,12 @@ bool menuModelCurveOne(event_t event)
   // Curve smooth
   lcdDrawText(MENUS_MARGIN_LEFT, MENU_CONTENT_TOP + 2*FH, STR_SMOOTH);
   drawCheckBox(MODEL_CURVE_ONE_2ND_COLUMN, MENU_CONTENT_TOP + 2*FH, crv.smooth, menuVerticalPosition==ITEM_CURVE_SMOOTH ? INVERS : 0);
-  if (menuVerticalPosition==ITEM_CURVE_SMOOTH) crv.smooth = checkIncDecModel(event, crv.smooth, 0, 1);
+  if (menuVerticalPosition==ITEM_CURVE_SMOOTH) {
+    crv.smooth = checkIncDecModel(event, crv.smooth, 0, 1);
+    if (checkIncDec_Ret) {
+      invalidateCurveLut(s_curveChan);
+    }
+  }
 
   switch(event) {
     case EVT_ENTRY:
@@ -239,6 +247,9 @@ bool menuModelCurveOne(event_t event)
           CHECK_INCDEC_MODELVAR(event, points[5+crv.points+i-1], i==1 ? -100 : points[5+crv.points+i-2], i==5+crv.points-2 ? 100 : points[5+crv.points+i]);  // edit X
         else if (selectionMode == 2)
           CHECK_INCDEC_MODELVAR(event, points[i], -100, 100);
+        if (checkIncDec_Ret) {
+          invalidateCurveLut(s_curveChan);
+        }
       }
       if (i < pointsOfs)
         pointsOfs = i;
@@ -328,9 +328,14 @@ bool menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
             }
           }
           else if (func == FUNC_LOGS) {
-            if (val_displayed) {
+            val_min = -LOGS_FAST_PERIOD_MAX;
+            if (val_displayed > 0) {
               lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, val_displayed, attr|PREC1|LEFT, 0, NULL, "s");
             }
+            else if (val_displayed < 0) {
+              // fast (binary) logs
+              lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, -val_displayed * LOGS_FAST_PERIOD_TICKS * 2, attr|LEFT, 0, NULL, "ms");
+            }
             else {
               lcdDrawMMM(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, attr);
             }
@@ -188,6 +188,51 @@ bool menuStatsAnalogs(event_t event)
   return true;
 }
 
+bool menuStatsTelemetry(event_t event)
+{
+  switch(event)
+  {
+    case EVT_KEY_FIRST(KEY_ENTER):
+      telemetryLinkStatsReset();
+      break;
+  }
+
+  SIMPLE_MENU("Telemetry", STATS_ICONS, menuTabStats, e_StatsTelemetry, 1);
+
+  lcdDrawText(MENUS_MARGIN_LEFT, MENU_CONTENT_TOP, "Protocol");
+  lcdDrawNumber(MENU_STATS_COLUMN1, MENU_CONTENT_TOP, telemetryLinkStats.protocol, LEFT);
+  lcdDrawText(lcdNextPos+20, MENU_CONTENT_TOP+1, telemetryLinkStats.module == INTERNAL_MODULE ? "[Int]" : "[Ext]", HEADER_COLOR|SMLSIZE);
+
+  lcdDrawText(MENUS_MARGIN_LEFT, MENU_CONTENT_TOP+FH, "Frames");
+  lcdDrawNumber(MENU_STATS_COLUMN1, MENU_CONTENT_TOP+FH, telemetryLinkStats.frames, LEFT);
+
+  lcdDrawText(MENUS_MARGIN_LEFT, MENU_CONTENT_TOP+2*FH, "Errors");
+  lcdDrawText(MENU_STATS_COLUMN1, MENU_CONTENT_TOP+2*FH+1, "[CRC]", HEADER_COLOR|SMLSIZE);
+  lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+2*FH, telemetryLinkStats.crcErrors, LEFT);
+  lcdDrawText(lcdNextPos+20, MENU_CONTENT_TOP+2*FH+1, "[Resync]", HEADER_COLOR|SMLSIZE);
+  lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+2*FH, telemetryLinkStats.resyncs, LEFT);
+  lcdDrawText(lcdNextPos+20, MENU_CONTENT_TOP+2*FH+1, "[Overrun]", HEADER_COLOR|SMLSIZE);
+  lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+2*FH, telemetryLinkStats.overruns, LEFT);
+
+  lcdDrawText(MENUS_MARGIN_LEFT, MENU_CONTENT_TOP+3*FH, "Decode time");
+  lcdDrawText(MENU_STATS_COLUMN1, MENU_CONTENT_TOP+3*FH+1, "[Avg]", HEADER_COLOR|SMLSIZE);
+  lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+3*FH, telemetryLinkStats.frames ? telemetryLinkStats.decodeTime / 2 / telemetryLinkStats.frames : 0, LEFT, 0, NULL, "us");
+  lcdDrawText(lcdNextPos+20, MENU_CONTENT_TOP+3*FH+1, "[Max]", HEADER_COLOR|SMLSIZE);
+  lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+3*FH, telemetryLinkStats.decodeTimeMax / 2, LEFT, 0, NULL, "us");
+
+  // inter-frame gaps histogram, 2 buckets per line
+  for (uint8_t i=0; i<TELEMETRY_GAPS_COUNT; i++) {
+    coord_t y = MENU_CONTENT_TOP + (4+i/2)*FH;
+    coord_t x = MENUS_MARGIN_LEFT + (i & 1 ? LCD_W/2 : 0);
+    lcdDrawText(x, y, i == TELEMETRY_GAPS_COUNT-1 ? ">=" : "<");
+    lcdDrawNumber(lcdNextPos+2, y, i == TELEMETRY_GAPS_COUNT-1 ? 1 << i : 2 << i, LEFT, 0, NULL, "ms");
+    lcdDrawNumber(x+100, y, telemetryLinkStats.gaps[i], LEFT);
+  }
+
+  lcdDrawText(LCD_W/2, MENU_FOOTER_TOP, STR_MENUTORESET, MENU_TITLE_COLOR | CENTERED);
+  return true;
+}
+
 
 #if defined(DEBUG_TRACE_BUFFER)
 #define STATS_TRACES_INDEX_POS         MENUS_MARGIN_LEFT
@@ -48,7 +48,10 @@ void setGVarValue(uint8_t idx, int8_t value)
 uint8_t gvarDisplayTimer = 0;
 uint8_t gvarLastChanged = 0;
 
-uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+uint8_t gvarFlightModes[MAX_FLIGHT_MODES][MAX_GVARS];
+bool gvarFlightModesDirty = true;
+
+static uint8_t resolveGVarFlightMode(uint8_t fm, uint8_t gv)
 {
   for (uint8_t i=0; i<MAX_FLIGHT_MODES; i++) {
     if (fm == 0) return 0;
@@ -61,6 +64,18 @@ uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to
   return 0;
 }
 
+void buildGVarFlightModes()
+{
+  // cleared first, so that a modification done while we are building is not lost
+  gvarFlightModesDirty = false;
+
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv=0; gv<MAX_GVARS; gv++) {
+      gvarFlightModes[fm][gv] = resolveGVarFlightMode(fm, gv);
+    }
+  }
+}
+
 int16_t getGVarValue(int8_t gv, int8_t fm)
 {
   int8_t mul = 1;
@@ -25,13 +25,13 @@
   // GVars are common to all flight modes
   #define GVAR_VALUE(x, p)             g_model.gvars[x]
   #define SET_GVAR_VALUE(idx, phase, value) \
-    (GVAR_VALUE(idx, phase) = value, storageDirty(EE_MODEL))
+    (GVAR_VALUE(idx, phase) = value, storageDirtyValue(EE_MODEL))
 #else
   // GVars have one value per flight mode
   #define GVAR_VALUE(gv, fm)           g_model.flightModeData[fm].gvars[gv]
   #define SET_GVAR_VALUE(idx, phase, value) \
     GVAR_VALUE(idx, phase) = value; \
-    storageDirty(EE_MODEL); \
+    storageDirtyValue(EE_MODEL); \
     if (g_model.gvars[idx].popup) { \
       gvarLastChanged = idx; \
       gvarDisplayTimer = GVAR_DISPLAY_TIME; \
@@ -45,7 +45,22 @@
     #define GET_GVAR(x, min, max, fm)  getGVarFieldValue(x, min, max)
     #define SET_GVAR(idx, val, fm)     setGVarValue(idx, val)
   #else
-    uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv);
+    // Flight mode owning the value of each GVAR, for each flight mode.
+    // Rebuilt on first access after the model has been changed
+    extern uint8_t gvarFlightModes[MAX_FLIGHT_MODES][MAX_GVARS];
+    extern bool gvarFlightModesDirty;
+    void buildGVarFlightModes();
+    inline void invalidateGVarFlightModes()
+    {
+      gvarFlightModesDirty = true;
+    }
+    inline uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+    {
+      if (gvarFlightModesDirty) {
+        buildGVarFlightModes();
+      }
+      return gvarFlightModes[fm][gv];
+    }
     int16_t getGVarFieldValue(int16_t x, int16_t min, int16_t max, int8_t fm);
     int32_t getGVarFieldValuePrec1(int16_t x, int16_t min, int16_t max, int8_t fm);
     int16_t getGVarValue(int8_t gv, int8_t fm);
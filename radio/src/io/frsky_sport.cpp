@@ -67,17 +67,11 @@ bool isSportOutputBufferAvailable()
 // TODO merge it with S.PORT update function when finished
 void sportOutputPushPacket(SportTelemetryPacket * packet)
 {
-  uint16_t crc = 0;
-
   for (uint8_t i=1; i<sizeof(SportTelemetryPacket); i++) {
-    uint8_t byte = packet->raw[i];
-    sportOutputPushByte(byte);
-    crc += byte; // 0-1FF
-    crc += crc >> 8; // 0-100
-    crc &= 0x00ff;
+    sportOutputPushByte(packet->raw[i]);
   }
 
-  telemetryOutputPushByte(0xFF-crc);
+  telemetryOutputPushByte(0xFF - sportChecksum(packet->raw+1, sizeof(SportTelemetryPacket)-1));
   telemetryOutputSetTrigger(packet->raw[0]); // physicalId
 }
 
@@ -20,6 +20,8 @@
 
 #include "opentx.h"
 #include "ff.h"
+#include <stdarg.h>
+#include <stdio.h>
 
 FIL g_oLogFile __DMA;
 const pm_char * g_logError = NULL;
@@ -27,6 +29,201 @@ uint8_t logDelay;
 
 void writeHeader();
 
+#if defined(CPUARM)
+// Ring buffer filled by one task, and written to its file by the logs task, by
+// whole sectors. The ring indexes are the file offsets, so that the ring and
+// the file sectors are aligned. A record (a CSV line, a fast logs sample) is
+// only published once complete, a record which doesn't fit is dropped.
+class LogsBuffer
+{
+  public:
+    LogsBuffer(FIL * file, uint8_t * data, uint32_t size, LogsStats & stats):
+      file(file),
+      data(data),
+      size(size),
+      stats(stats)
+    {
+    }
+
+    // Called once the file is opened, before the first record
+    void reset()
+    {
+      widx = ridx = f_size(file);
+      failed = false;
+    }
+
+    void recordStart()
+    {
+      idx = widx;
+      overrun = false;
+    }
+
+    void write(const void * buffer, uint32_t len)
+    {
+      if (idx + len - ridx > size) {
+        overrun = true;
+      }
+      if (!overrun) {
+        const uint8_t * bytes = (const uint8_t *)buffer;
+        while (len--) {
+          data[idx++ & (size-1)] = *bytes++;
+        }
+      }
+    }
+
+    void recordEnd()
+    {
+      if (overrun) {
+        stats.overruns++;
+      }
+      else {
+        uint32_t count = idx - ridx;
+        if (count > stats.bufferMax) {
+          stats.bufferMax = count;
+        }
+        stats.records++;
+        widx = idx;
+      }
+    }
+
+    bool isFlushNeeded() const
+    {
+      return widx - ridx >= size / 2;
+    }
+
+    // Writes the buffered data to the file, by whole sectors unless all is
+    // set. Called with the logs mutex taken
+    void flush(bool all)
+    {
+      if (!file->obj.fs || failed) {
+        return;
+      }
+
+      uint32_t start = CoGetOSTime();
+      uint32_t end = widx;
+      if (!all) {
+        end &= ~(LOGS_SECTOR_SIZE-1);
+      }
+
+      if ((int32_t)(end - ridx) <= 0) {
+        return;
+      }
+
+      while (ridx != end) {
+        // at most 2 chunks, the ring end being on a sector boundary
+        uint32_t offset = ridx & (size-1);
+        UINT count = min<uint32_t>(end - ridx, size - offset);
+        UINT written;
+        if (f_write(file, &data[offset], count, &written) != FR_OK || written != count) {
+          failed = true;
+          break;
+        }
+        ridx += count;
+        stats.bytes += count;
+      }
+
+      uint32_t duration = (uint32_t)CoGetOSTime() - start;
+      stats.flushes++;
+      stats.flushTimeSum += duration;
+      if (duration > stats.flushTimeMax) {
+        stats.flushTimeMax = duration;
+      }
+    }
+
+    // Called from the menus task
+    void close()
+    {
+      CoEnterMutexSection(logsMutex);
+      if (file->obj.fs) {
+        flush(true);
+        if (f_close(file) != FR_OK) {
+          // close failed, forget file
+          file->obj.fs = 0;
+        }
+      }
+      failed = false;
+      CoLeaveMutexSection(logsMutex);
+    }
+
+    FIL * const file;
+    volatile bool failed;
+
+  protected:
+    uint8_t * const data;
+    const uint32_t size;
+    LogsStats & stats;
+    volatile uint32_t widx;  // end of the last complete record
+    volatile uint32_t ridx;  // end of the data written to the file
+    uint32_t idx;            // end of the record being written
+    bool overrun;
+};
+
+static uint8_t logsData[LOGS_BUFFER_SIZE] __SDRAM;
+LogsStats logsStats;
+static LogsBuffer logsBuffer(&g_oLogFile, logsData, LOGS_BUFFER_SIZE, logsStats);
+
+static FIL logsFastFile __DMA;
+static uint8_t logsFastData[LOGS_FAST_BUFFER_SIZE] __SDRAM;
+LogsStats logsFastStats;
+static LogsBuffer logsFastBuffer(&logsFastFile, logsFastData, LOGS_FAST_BUFFER_SIZE, logsFastStats);
+
+static void logsPuts(const char * str)
+{
+  logsBuffer.write(str, strlen(str));
+}
+
+static void logsPutc(char c)
+{
+  logsBuffer.write(&c, 1);
+}
+
+static void logsPrintf(const char * format, ...)
+{
+  char line[LOGS_PRINTF_BUFFER_SIZE];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+  if (len > 0) {
+    logsBuffer.write(line, min<int>(len, sizeof(line)-1));
+  }
+}
+
+void logsStatsReset()
+{
+  memset(&logsStats, 0, sizeof(logsStats));
+  memset(&logsFastStats, 0, sizeof(logsFastStats));
+}
+
+void logsTask(void * pdata)
+{
+  while (1) {
+    CoTickDelay(LOGS_TASK_PERIOD_TICKS);
+
+#if defined(SIMU)
+    if (main_thread_running == 0)
+      break;
+#endif
+
+    if (logsFastBuffer.isFlushNeeded()) {
+      CoEnterMutexSection(logsMutex);
+      logsFastBuffer.flush(false);
+      CoLeaveMutexSection(logsMutex);
+    }
+
+    if (logsBuffer.isFlushNeeded()) {
+      CoEnterMutexSection(logsMutex);
+      logsBuffer.flush(false);
+      CoLeaveMutexSection(logsMutex);
+    }
+  }
+}
+#else
+  #define logsPrintf(...)  f_printf(&g_oLogFile, __VA_ARGS__)
+  #define logsPuts(str)    f_puts(str, &g_oLogFile)
+  #define logsPutc(c)      f_putc(c, &g_oLogFile)
+#endif
+
 #if defined(PCBTARANIS) || defined(PCBHORUS)
   #define GET_2POS_STATE(sw) (switchState(SW_ ## sw ## 0) ? -1 : 1)
 #else
@@ -41,11 +238,11 @@ void logsInit()
   memset(&g_oLogFile, 0, sizeof(g_oLogFile));
 }
 
-const pm_char * logsOpen()
+static const pm_char * logsOpenFile(FIL * file, const pm_char * ext, bool time)
 {
   // Determine and set log file filename
   FRESULT result;
-  char filename[34]; // /LOGS/modelnamexxx-2013-01-01.log
+  char filename[sizeof(LOGS_PATH) + sizeof(g_model.header.name) + sizeof("-2013-01-01-000000") + LEN_FILE_EXTENSION_MAX]; // /LOGS/modelnamexxx-2013-01-01.csv
 
   if (!sdMounted())
     return STR_NO_SDCARD;
@@ -94,32 +291,262 @@ const pm_char * logsOpen()
   char * tmp = &filename[len];
 
 #if defined(RTCLOCK)
-  tmp = strAppendDate(&filename[len]);
+  tmp = strAppendDate(&filename[len], time);
 #endif
 
-  strcpy_P(tmp, STR_LOGS_EXT);
+  strcpy_P(tmp, ext);
 
-  result = f_open(&g_oLogFile, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
+  // the files named to the second (fast logs) start with their own header,
+  // one opened again within the same second is truncated rather than appended
+  if (time)
+    result = f_open(file, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  else
+    result = f_open(file, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
-  if (f_size(&g_oLogFile) == 0) {
-    writeHeader();
+#if defined(CPUARM)
+  if (f_size(file) == 0) {
+    // nothing is allocated, but the file clusters will then be taken from
+    // a contiguous free block
+    f_expand(file, LOGS_EXPAND_SIZE, 0);
   }
+#endif
 
   return NULL;
 }
 
+const pm_char * logsOpen()
+{
+#if defined(CPUARM)
+  CoEnterMutexSection(logsMutex);
+  const pm_char * result = logsOpenFile(&g_oLogFile, STR_LOGS_EXT, false);
+  if (!result) {
+    logsBuffer.reset();
+    if (f_size(&g_oLogFile) == 0) {
+      logsBuffer.recordStart();
+      writeHeader();
+      logsBuffer.recordEnd();
+    }
+  }
+  CoLeaveMutexSection(logsMutex);
+  return result;
+#else
+  const pm_char * result = logsOpenFile(&g_oLogFile, STR_LOGS_EXT, false);
+  if (!result && f_size(&g_oLogFile) == 0) {
+    writeHeader();
+  }
+  return result;
+#endif
+}
+
+#if defined(CPUARM)
+enum LogsFastSourceType {
+  LOGS_FAST_ANALOG,
+  LOGS_FAST_CHANNEL,
+  LOGS_FAST_SENSOR,
+};
+
+struct LogsFastSource {
+  uint8_t type;
+  uint8_t index;
+};
+
+#define LOGS_FAST_MAX_COLUMNS  (NUM_STICKS+NUM_POTS+NUM_SLIDERS+MAX_OUTPUT_CHANNELS+MAX_TELEMETRY_SENSORS)
+
+static_assert(sizeof(LogsFastRecord) + LOGS_FAST_MAX_COLUMNS*sizeof(int32_t) <= LOGS_FAST_BUFFER_SIZE/2, "LOGS_FAST_BUFFER_SIZE too small for the records");
+
+uint8_t logsFastPeriod;
+static uint8_t logsFastTicks;
+static uint32_t logsFastStartTime;
+static uint32_t logsFastNextTime;
+static LogsFastSource logsFastSources[LOGS_FAST_MAX_COLUMNS];
+static uint8_t logsFastColumnsCount;
+static volatile bool logsFastRunning;
+
+// The columns are not chosen one by one, there is no room for such a list in
+// the model: they are all the sticks, pots and sliders, the used channels and
+// the sensors which have their Logs option set, as in the CSV logs.
+// The header is written straight to the file when it is opened, the buffer
+// only has to hold a few records
+static const pm_char * logsFastWriteHeader()
+{
+  logsFastColumnsCount = 0;
+  for (uint8_t i=0; i<NUM_STICKS+NUM_POTS+NUM_SLIDERS; i++) {
+    logsFastSources[logsFastColumnsCount++] = { LOGS_FAST_ANALOG, i };
+  }
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    if (isChannelUsed(i)) {
+      logsFastSources[logsFastColumnsCount++] = { LOGS_FAST_CHANNEL, i };
+    }
+  }
+  for (uint8_t i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    if (isTelemetryFieldAvailable(i) && sensor.logs && sensor.unit < UNIT_DATETIME) {
+      logsFastSources[logsFastColumnsCount++] = { LOGS_FAST_SENSOR, i };
+    }
+  }
+
+  LogsFastHeader header;
+  header.fourcc = LOGS_FAST_FOURCC;
+  header.version = LOGS_FAST_VERSION;
+  header.period = logsFastTicks * 2;
+  header.columns = logsFastColumnsCount;
+#if defined(RTCLOCK)
+  header.startTime = g_rtcTime;
+#else
+  header.startTime = 0;
+#endif
+  UINT written;
+  FRESULT result = f_write(&logsFastFile, &header, sizeof(header), &written);
+
+  for (uint8_t i=0; i<logsFastColumnsCount && result == FR_OK; i++) {
+    LogsFastSource & source = logsFastSources[i];
+    LogsFastColumn column;
+    memclear(&column, sizeof(column));
+    if (source.type == LOGS_FAST_ANALOG) {
+      const char * name = STR_VSRCRAW + (source.index + 1) * STR_VSRCRAW[0] + 2;
+      for (uint8_t j=0; j<STR_VSRCRAW[0]-1 && name[j]; j++) {
+        column.name[j] = name[j];
+      }
+      column.size = sizeof(int16_t);
+    }
+    else if (source.type == LOGS_FAST_CHANNEL) {
+      strAppendUnsigned(strAppend(column.name, "CH"), source.index + 1);
+      column.unit[0] = '%';
+      column.precision = 1;
+      column.size = sizeof(int16_t);
+    }
+    else {
+      TelemetrySensor & sensor = g_model.telemetrySensors[source.index];
+      zchar2str(column.name, sensor.label, TELEM_LABEL_LEN);
+      uint8_t unit = (sensor.unit == UNIT_CELLS ? UNIT_VOLTS : sensor.unit);
+      if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
+        strncpy(column.unit, STR_VTELEMUNIT+1+3*unit, 3);
+      }
+      column.precision = sensor.prec;
+      column.size = sizeof(int32_t);
+    }
+    result = f_write(&logsFastFile, &column, sizeof(column), &written);
+  }
+
+  return result == FR_OK ? NULL : SDCARD_ERROR(result);
+}
+
+static const pm_char * logsFastOpen()
+{
+  CoEnterMutexSection(logsMutex);
+  const pm_char * result = logsOpenFile(&logsFastFile, LOGS_FAST_EXT, true);
+  if (!result) {
+    logsFastTicks = logsFastPeriod * LOGS_FAST_PERIOD_TICKS;
+    result = logsFastWriteHeader();
+    if (result) {
+      f_close(&logsFastFile);
+      logsFastFile.obj.fs = 0;
+    }
+  }
+  if (!result) {
+    logsFastBuffer.reset();
+    logsFastStartTime = logsFastNextTime = CoGetOSTime();
+    logsFastRunning = true;
+  }
+  CoLeaveMutexSection(logsMutex);
+  return result;
+}
+
+static void logsFastClose()
+{
+  logsFastRunning = false;
+  logsFastBuffer.close();
+}
+
+// Called from the mixer task, after each mixer run
+void logsFastSample()
+{
+  if (!logsFastRunning) {
+    return;
+  }
+
+  uint32_t now = CoGetOSTime();
+  if ((int32_t)(now - logsFastNextTime) < 0) {
+    return;
+  }
+
+  // missed samples are not caught up
+  logsFastNextTime += logsFastTicks;
+  if ((int32_t)(now - logsFastNextTime) >= 0) {
+    logsFastNextTime = now + logsFastTicks;
+  }
+
+  logsFastBuffer.recordStart();
+  LogsFastRecord record;
+  record.time = (now - logsFastStartTime) * 2/*ms*/;
+  logsFastBuffer.write(&record, sizeof(record));
+  for (uint8_t i=0; i<logsFastColumnsCount; i++) {
+    LogsFastSource & source = logsFastSources[i];
+    if (source.type == LOGS_FAST_ANALOG) {
+      int16_t value = calibratedAnalogs[source.index];
+      logsFastBuffer.write(&value, sizeof(value));
+    }
+    else if (source.type == LOGS_FAST_CHANNEL) {
+      int16_t value = calcRESXto1000(channelOutputs[source.index]);
+      logsFastBuffer.write(&value, sizeof(value));
+    }
+    else {
+      int32_t value = telemetryItems[source.index].value;
+      logsFastBuffer.write(&value, sizeof(value));
+    }
+  }
+  logsFastBuffer.recordEnd();
+}
+
+static void logsFastWrite()
+{
+  static const pm_char * error_displayed = NULL;
+
+  if (isFunctionActive(FUNCTION_LOGS_FAST) && logsFastPeriod > 0) {
+    if (!logsFastFile.obj.fs) {
+      const pm_char * result = logsFastOpen();
+      if (result != NULL) {
+        if (result != error_displayed) {
+          error_displayed = result;
+          POPUP_WARNING(result);
+        }
+        return;
+      }
+    }
+    if (logsFastBuffer.failed) {
+      if (!error_displayed) {
+        error_displayed = STR_SDCARD_ERROR;
+        POPUP_WARNING(STR_SDCARD_ERROR);
+      }
+      logsFastClose();
+    }
+  }
+  else {
+    error_displayed = NULL;
+    if (logsFastFile.obj.fs) {
+      logsFastClose();
+    }
+  }
+}
+#endif
+
 tmr10ms_t lastLogTime = 0;
 
 void logsClose()
 {
   if (sdMounted()) {
+#if defined(CPUARM)
+    logsFastClose();
+    logsBuffer.close();
+#else
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
     }
+#endif
     lastLogTime = 0;
   }
 }
@@ -135,24 +562,24 @@ getvalue_t getConvertedTelemetryValue(getvalue_t val, uint8_t unit)
 void writeHeader()
 {
 #if defined(RTCLOCK)
-  f_puts("Date,Time,", &g_oLogFile);
+  logsPuts("Date,Time,");
 #else
-  f_puts("Time,", &g_oLogFile);
+  logsPuts("Time,");
 #endif
 
 #if defined(TELEMETRY_FRSKY)
 #if !defined(CPUARM)
-  f_puts("Buffer,RX,TX,A1,A2,", &g_oLogFile);
+  logsPuts("Buffer,RX,TX,A1,A2,");
 #if defined(FRSKY_HUB)
   if (IS_USR_PROTO_FRSKY_HUB()) {
-    f_puts("GPS Date,GPS Time,Long,Lat,Course,GPS Speed(kts),GPS Alt,Baro Alt(", &g_oLogFile);
-    f_puts(TELEMETRY_BARO_ALT_UNIT, &g_oLogFile);
-    f_puts("),Vertical Speed,Air Speed(kts),Temp1,Temp2,RPM,Fuel," TELEMETRY_CELLS_LABEL "Current,Consumption,Vfas,AccelX,AccelY,AccelZ,", &g_oLogFile);
+    logsPuts("GPS Date,GPS Time,Long,Lat,Course,GPS Speed(kts),GPS Alt,Baro Alt(");
+    logsPuts(TELEMETRY_BARO_ALT_UNIT);
+    logsPuts("),Vertical Speed,Air Speed(kts),Temp1,Temp2,RPM,Fuel," TELEMETRY_CELLS_LABEL "Current,Consumption,Vfas,AccelX,AccelY,AccelZ,");
   }
 #endif
 #if defined(WS_HOW_HIGH)
   if (IS_USR_PROTO_WS_HOW_HIGH()) {
-    f_puts("WSHH Alt,", &g_oLogFile);
+    logsPuts("WSHH Alt,");
   }
 #endif
 #endif
@@ -173,7 +600,7 @@ void writeHeader()
           strcat(label, ")");
         }
         strcat(label, ",");
-        f_puts(label, &g_oLogFile);
+        logsPuts(label);
       }
     }
   }
@@ -185,10 +612,10 @@ void writeHeader()
     const char * p = STR_VSRCRAW + i * STR_VSRCRAW[0] + 2;
     for (uint8_t j=0; j<STR_VSRCRAW[0]-1; ++j) {
       if (!*p) break;
-      f_putc(*p, &g_oLogFile);
+      logsPutc(*p);
       ++p;
     }
-    f_putc(',', &g_oLogFile);
+    logsPutc(',');
   }
 #if defined(PCBX7)
   #define STR_SWITCHES_LOG_HEADER  "SA,SB,SC,SD,SF,SH"
@@ -197,12 +624,12 @@ void writeHeader()
 #else
   #define STR_SWITCHES_LOG_HEADER  "SA,SB,SC,SD,SE,SF,SG,SH"
 #endif
-  f_puts(STR_SWITCHES_LOG_HEADER ",LSW,", &g_oLogFile);
+  logsPuts(STR_SWITCHES_LOG_HEADER ",LSW,");
 #else
-  f_puts("Rud,Ele,Thr,Ail,P1,P2,P3,THR,RUD,ELE,3POS,AIL,GEA,TRN,", &g_oLogFile);
+  logsPuts("Rud,Ele,Thr,Ail,P1,P2,P3,THR,RUD,ELE,3POS,AIL,GEA,TRN,");
 #endif
 
-  f_puts("TxBat(V)\n", &g_oLogFile);
+  logsPuts("TxBat(V)\n");
 }
 
 uint32_t getLogicalSwitchesStates(uint8_t first)
@@ -218,6 +645,10 @@ void logsWrite()
 {
   static const pm_char * error_displayed = NULL;
 
+#if defined(CPUARM)
+  logsFastWrite();
+#endif
+
   if (isFunctionActive(FUNCTION_LOGS) && logDelay > 0) {
     tmr10ms_t tmr10ms = get_tmr10ms();
     if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)logDelay*10) {
@@ -234,6 +665,10 @@ void logsWrite()
         }
       }
 
+#if defined(CPUARM)
+      logsBuffer.recordStart();
+#endif
+
 #if defined(RTCLOCK)
       {
         static struct gtm utm;
@@ -242,25 +677,25 @@ void logsWrite()
           lastRtcTime = g_rtcTime;
           gettime(&utm);
         }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+        logsPrintf("%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
       }
 #else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
+      logsPrintf("%d,", tmr10ms);
 #endif
 
 #if defined(TELEMETRY_FRSKY)
 #if !defined(CPUARM)
-      f_printf(&g_oLogFile, "%d,%d,%d,", telemetryStreaming, RAW_FRSKY_MINMAX(telemetryData.rssi[0]), RAW_FRSKY_MINMAX(telemetryData.rssi[1]));
+      logsPrintf("%d,%d,%d,", telemetryStreaming, RAW_FRSKY_MINMAX(telemetryData.rssi[0]), RAW_FRSKY_MINMAX(telemetryData.rssi[1]));
       for (uint8_t i=0; i<MAX_FRSKY_A_CHANNELS; i++) {
         int16_t converted_value = applyChannelRatio(i, RAW_FRSKY_MINMAX(telemetryData.analog[i]));
-        f_printf(&g_oLogFile, "%d.%02d,", converted_value/100, converted_value%100);
+        logsPrintf("%d.%02d,", converted_value/100, converted_value%100);
       }
 
 #if defined(FRSKY_HUB)
       TELEMETRY_BARO_ALT_PREPARE();
 
       if (IS_USR_PROTO_FRSKY_HUB()) {
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d,%03d.%04d%c,%03d.%04d%c,%03d.%02d," TELEMETRY_GPS_SPEED_FORMAT TELEMETRY_GPS_ALT_FORMAT TELEMETRY_BARO_ALT_FORMAT TELEMETRY_VSPEED_FORMAT TELEMETRY_ASPEED_FORMAT "%d,%d,%d,%d," TELEMETRY_CELLS_FORMAT TELEMETRY_CURRENT_FORMAT "%d," TELEMETRY_VFAS_FORMAT "%d,%d,%d,",
+        logsPrintf("%4d-%02d-%02d,%02d:%02d:%02d,%03d.%04d%c,%03d.%04d%c,%03d.%02d," TELEMETRY_GPS_SPEED_FORMAT TELEMETRY_GPS_ALT_FORMAT TELEMETRY_BARO_ALT_FORMAT TELEMETRY_VSPEED_FORMAT TELEMETRY_ASPEED_FORMAT "%d,%d,%d,%d," TELEMETRY_CELLS_FORMAT TELEMETRY_CURRENT_FORMAT "%d," TELEMETRY_VFAS_FORMAT "%d,%d,%d,",
             telemetryData.hub.year+2000,
             telemetryData.hub.month,
             telemetryData.hub.day,
@@ -296,7 +731,7 @@ void logsWrite()
 
 #if defined(WS_HOW_HIGH)
       if (IS_USR_PROTO_WS_HOW_HIGH()) {
-        f_printf(&g_oLogFile, "%d,", TELEMETRY_RELATIVE_BARO_ALT_BP);
+        logsPrintf("%d,", TELEMETRY_RELATIVE_BARO_ALT_BP);
       }
 #endif
 #endif
@@ -310,31 +745,31 @@ void logsWrite()
             if (sensor.unit == UNIT_GPS) {
               if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
                 div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.latitude < 0) logsPutc('-');
+                logsPrintf("%d.%06d ", abs(qr.quot), abs(qr.rem));
                 qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.longitude < 0) logsPutc('-');
+                logsPrintf("%d.%06d,", abs(qr.quot), abs(qr.rem));
               }
               else {
-                f_printf(&g_oLogFile, ",");
+                logsPutc(',');
               }
             }
             else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
+              logsPrintf("%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
             }
             else if (sensor.prec == 2) {
               div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) logsPutc('-');
+              logsPrintf("%d.%02d,", abs(qr.quot), abs(qr.rem));
             }
             else if (sensor.prec == 1) {
               div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) logsPutc('-');
+              logsPrintf("%d.%d,", abs(qr.quot), abs(qr.rem));
             }
             else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
+              logsPrintf("%d,", telemetryItem.value);
             }
           }
         }
@@ -343,12 +778,12 @@ void logsWrite()
 #endif
 
       for (uint8_t i=0; i<NUM_STICKS+NUM_POTS+NUM_SLIDERS; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[i]);
+        logsPrintf("%d,", calibratedAnalogs[i]);
       }
 
 // TODO: use hardware config to populate
 #if defined(PCBXLITE)
-      f_printf(&g_oLogFile, "%d,%d,%d,%d,0x%08X%08X,",
+      logsPrintf("%d,%d,%d,%d,0x%08X%08X,",
           GET_3POS_STATE(SA),
           GET_3POS_STATE(SB),
           GET_3POS_STATE(SC),
@@ -356,7 +791,7 @@ void logsWrite()
           getLogicalSwitchesStates(32),
           getLogicalSwitchesStates(0));
 #elif defined(PCBX7)
-      f_printf(&g_oLogFile, "%d,%d,%d,%d,%d,%d,0x%08X%08X,",
+      logsPrintf("%d,%d,%d,%d,%d,%d,0x%08X%08X,",
           GET_3POS_STATE(SA),
           GET_3POS_STATE(SB),
           GET_3POS_STATE(SC),
@@ -366,7 +801,7 @@ void logsWrite()
           getLogicalSwitchesStates(32),
           getLogicalSwitchesStates(0));
 #elif defined(PCBTARANIS) || defined(PCBHORUS)
-      f_printf(&g_oLogFile, "%d,%d,%d,%d,%d,%d,%d,%d,0x%08X%08X,",
+      logsPrintf("%d,%d,%d,%d,%d,%d,%d,%d,0x%08X%08X,",
           GET_3POS_STATE(SA),
           GET_3POS_STATE(SB),
           GET_3POS_STATE(SC),
@@ -378,7 +813,7 @@ void logsWrite()
           getLogicalSwitchesStates(32),
           getLogicalSwitchesStates(0));
 #else
-      f_printf(&g_oLogFile, "%d,%d,%d,%d,%d,%d,%d,",
+      logsPrintf("%d,%d,%d,%d,%d,%d,%d,",
           GET_2POS_STATE(THR),
           GET_2POS_STATE(RUD),
           GET_2POS_STATE(ELE),
@@ -389,7 +824,21 @@ void logsWrite()
 #endif
 
       div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
+#if defined(CPUARM)
+      logsPrintf("%d.%d\n", abs(qr.quot), abs(qr.rem));
+      logsBuffer.recordEnd();
+    }
+
+    if (logsBuffer.failed) {
+      if (!error_displayed) {
+        error_displayed = STR_SDCARD_ERROR;
+        POPUP_WARNING(STR_SDCARD_ERROR);
+      }
+      logsBuffer.close();
+      lastLogTime = 0;
+    }
+#else
+      int result = logsPrintf("%d.%d\n", abs(qr.quot), abs(qr.rem));
 
       if (result<0 && !error_displayed) {
         error_displayed = STR_SDCARD_ERROR;
@@ -397,11 +846,17 @@ void logsWrite()
         logsClose();
       }
     }
+#endif
   }
   else {
     error_displayed = NULL;
     if (g_oLogFile.obj.fs) {
+#if defined(CPUARM)
+      logsBuffer.close();
+      lastLogTime = 0;
+#else
       logsClose();
+#endif
     }
   }
 }
@@ -668,19 +668,21 @@ Return the internal GPS position or nil if no valid hardware found
  * 'alt' (number) internal GPS altitude in 0.1m
  * 'speed' (number) internal GPSspeed in 0.1m/s
  * 'heading'  (number) internal GPS ground course estimation in degrees * 10
+ * 'hdop' (number) internal GPS horizontal dilution of precision * 100
 
 @status current Introduced in 2.2.2
 */
 static int luaGetTxGPS(lua_State * L)
 {
 #if defined(INTERNAL_GPS)
-  lua_createtable(L, 0, 7);
+  lua_createtable(L, 0, 8);
   lua_pushtablenumber(L, "lat", gpsData.latitude * 0.000001);
   lua_pushtablenumber(L, "lon", gpsData.longitude * 0.000001);
   lua_pushtableinteger(L, "numsat", gpsData.numSat);
   lua_pushtableinteger(L, "alt", gpsData.altitude);
   lua_pushtableinteger(L, "speed", gpsData.speed);
   lua_pushtableinteger(L, "heading", gpsData.groundCourse);
+  lua_pushtableinteger(L, "hdop", gpsData.hdop);
   if (gpsData.fix)
     lua_pushtableboolean(L, "fix", true);
   else
@@ -1114,6 +1116,7 @@ static int luaSetTelemetryValue(lua_State * L)
       telemetrySensor.subId = subId;
       telemetrySensor.instance = instance;
       telemetrySensor.init(zname, unit, prec);
+      invalidateTelemetrySensorsIndex();
       lua_pushboolean(L, true);
     } else {
       lua_pushboolean(L, false);
@@ -1172,6 +1175,46 @@ static int luaGetRSSI(lua_State * L)
   return 3;
 }
 
+/*luadoc
+@function getTelemetryStats()
+
+Get the telemetry receive link statistics, reset when the telemetry protocol changes
+
+@retval table with the following fields:
+ * `protocol` (number) telemetry protocol
+ * `module` (number) module the telemetry is received from (0 internal, 1 external)
+ * `frames` (number) valid frames received
+ * `crcErrors` (number) frames dropped because of a bad checksum
+ * `resyncs` (number) times the framing was lost
+ * `overruns` (number) bytes lost because the receive fifo was full
+ * `decodeTime` (number) total time spent decoding, in us
+ * `decodeTimeMax` (number) longest decoding, in us
+ * `gaps` (table) inter-frame gaps histogram, `gaps[i]` counts the gaps shorter than 2^i ms, the last entry all the longer ones
+
+@status current Introduced in 2.2.2
+*/
+static int luaGetTelemetryStats(lua_State * L)
+{
+  lua_createtable(L, 0, 9);
+  lua_pushtableinteger(L, "protocol", telemetryLinkStats.protocol);
+  lua_pushtableinteger(L, "module", telemetryLinkStats.module);
+  lua_pushtableinteger(L, "frames", telemetryLinkStats.frames);
+  lua_pushtableinteger(L, "crcErrors", telemetryLinkStats.crcErrors);
+  lua_pushtableinteger(L, "resyncs", telemetryLinkStats.resyncs);
+  lua_pushtableinteger(L, "overruns", telemetryLinkStats.overruns);
+  lua_pushtableinteger(L, "decodeTime", telemetryLinkStats.decodeTime / 2);
+  lua_pushtableinteger(L, "decodeTimeMax", telemetryLinkStats.decodeTimeMax / 2);
+  lua_pushstring(L, "gaps");
+  lua_createtable(L, TELEMETRY_GAPS_COUNT, 0);
+  for (int i = 0; i < TELEMETRY_GAPS_COUNT; i++) {
+    lua_pushnumber(L, i + 1);
+    lua_pushinteger(L, telemetryLinkStats.gaps[i]);
+    lua_settable(L, -3);
+  }
+  lua_settable(L, -3);
+  return 1;
+}
+
 /*luadoc
 @function loadScript(file [, mode], [,env])
 
@@ -1304,6 +1347,7 @@ const luaL_Reg opentxLib[] = {
   { "defaultStick", luaDefaultStick },
   { "defaultChannel", luaDefaultChannel },
   { "getRSSI", luaGetRSSI },
+  { "getTelemetryStats", luaGetTelemetryStats },
   { "killEvents", luaKillEvents },
   { "loadScript", luaLoadScript },
   { "getUsage", luaGetUsage },
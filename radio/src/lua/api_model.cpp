@@ -645,6 +645,7 @@ static int luaModelInsertMix(lua_State *L)
         mix->speedDown = luaL_checkinteger(L, -1);
       }
     }
+    storageDirty(EE_MODEL);
   }
 
   return 0;
@@ -686,6 +687,7 @@ Remove all mixers
 static int luaModelDeleteMixes(lua_State *L)
 {
   memset(g_model.mixData, 0, sizeof(g_model.mixData));
+  storageDirty(EE_MODEL);
   return 0;
 }
 
@@ -1034,6 +1036,7 @@ static int luaModelSetCurve(lua_State *L)
       *point++ = xPoints[i];
     }
   }
+  invalidateCurveLut(curveIdx);
   storageDirty(EE_MODEL);
 
   lua_pushinteger(L, 0);
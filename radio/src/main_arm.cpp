@@ -408,6 +408,12 @@ void perMain()
   checkSpeakerVolume();
   checkEeprom();
   logsWrite();
+#if defined(INPUTS_RECORDER)
+  recordWrite();
+#endif
+#if defined(LOG_TELEMETRY)
+  telemetryCaptureWrite();
+#endif
   handleUsbConnection();
   checkTrainerSettings();
   periodicTick();
@@ -330,38 +330,209 @@ int16_t applyLimits(uint8_t channel, int32_t value)
 
 // TODO same naming convention than the drawSource
 
-getvalue_t getValue(mixsrc_t i)
+#if defined(CPUARM)
+static getvalue_t getZeroSourceValue(mixsrc_t i)
 {
-  if (i == MIXSRC_NONE) {
-    return 0;
-  }
+  return 0;
+}
 
-#if defined(VIRTUAL_INPUTS)
-  else if (i <= MIXSRC_LAST_INPUT) {
-    return anas[i-MIXSRC_FIRST_INPUT];
-  }
-#endif
+static getvalue_t getInputSourceValue(mixsrc_t i)
+{
+  return anas[i-MIXSRC_FIRST_INPUT];
+}
 
 #if defined(LUA_INPUTS)
-  else if (i < MIXSRC_LAST_LUA) {
+static getvalue_t getLuaSourceValue(mixsrc_t i)
+{
 #if defined(LUA_MODEL_SCRIPTS)
-    div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-    return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
+  div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
+  return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
 #else
+  return 0;
+#endif
+}
+#endif
+
+static getvalue_t getAnalogSourceValue(mixsrc_t i)
+{
+  return calibratedAnalogs[i-MIXSRC_Rud];
+}
+
+#if defined(ROTARY_ENCODERS)
+static getvalue_t getRotaryEncoderSourceValue(mixsrc_t i)
+{
+  return getRotaryEncoder(i-MIXSRC_REa);
+}
+#endif
+
+static getvalue_t getMaxSourceValue(mixsrc_t i)
+{
+  return 1024;
+}
+
+static getvalue_t getHeliSourceValue(mixsrc_t i)
+{
+#if defined(HELI)
+  return cyc_anas[i-MIXSRC_CYC1];
+#else
+  return 0;
+#endif
+}
+
+static getvalue_t getTrimSourceValue(mixsrc_t i)
+{
+  return calc1000toRESX((int16_t)8 * getTrimValue(mixerCurrentFlightMode, i-MIXSRC_FIRST_TRIM));
+}
+
+#if defined(PCBTARANIS) || defined(PCBHORUS)
+static getvalue_t getSwitchSourceValue(mixsrc_t i)
+{
+  mixsrc_t sw = i-MIXSRC_FIRST_SWITCH;
+  if (SWITCH_EXISTS(sw)) {
+    return (switchState(3*sw) ? -1024 : (switchState(3*sw+1) ? 0 : 1024));
+  }
+  else {
     return 0;
+  }
+}
+#else
+static getvalue_t getSwitchSourceValue(mixsrc_t i)
+{
+  if (i == MIXSRC_3POS) {
+    return (getSwitch(SW_ID0+1) ? -1024 : (getSwitch(SW_ID1+1) ? 0 : 1024));
+  }
+  // don't use switchState directly to give getSwitch possibility to hack values if needed for switch warning
+  return getSwitch(SWSRC_THR+i-MIXSRC_THR) ? 1024 : -1024;
+}
 #endif
+
+static getvalue_t getLogicalSwitchSourceValue(mixsrc_t i)
+{
+  return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH+i-MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
+}
+
+static getvalue_t getTrainerSourceValue(mixsrc_t i)
+{
+  int16_t x = ppmInput[i-MIXSRC_FIRST_TRAINER];
+  if (i<MIXSRC_FIRST_TRAINER+NUM_CAL_PPM) {
+    x -= g_eeGeneral.trainer.calib[i-MIXSRC_FIRST_TRAINER];
   }
+  return x*2;
+}
+
+static getvalue_t getChannelSourceValue(mixsrc_t i)
+{
+  return ex_chans[i-MIXSRC_CH1];
+}
+
+#if defined(GVARS)
+static getvalue_t getGVarSourceValue(mixsrc_t i)
+{
+  return GVAR_VALUE(i-MIXSRC_GVAR1, getGVarFlightMode(mixerCurrentFlightMode, i - MIXSRC_GVAR1));
+}
+#endif
+
+static getvalue_t getTxVoltageSourceValue(mixsrc_t i)
+{
+  return g_vbat100mV;
+}
+
+static getvalue_t getTxTimeSourceValue(mixsrc_t i)
+{
+  // TX_TIME + SPARES
+#if defined(RTCLOCK)
+  return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
+#else
+  return 0;
 #endif
+}
 
+static getvalue_t getTimerSourceValue(mixsrc_t i)
+{
+  return timersStates[i-MIXSRC_FIRST_TIMER].val;
+}
+
+static getvalue_t getTelemetrySourceValue(mixsrc_t i)
+{
+  if (IS_FAI_FORBIDDEN(i)) {
+    return 0;
+  }
+  i -= MIXSRC_FIRST_TELEM;
+  div_t qr = div(i, 3);
+  TelemetryItem & telemetryItem = telemetryItems[qr.quot];
+  switch (qr.rem) {
+    case 1:
+      return telemetryItem.valueMin;
+    case 2:
+      return telemetryItem.valueMax;
+    default:
+      return telemetryItem.value;
+  }
+}
+
+struct SourceRange {
+  mixsrc_t last;                        // the range starts after the previous one
+  getvalue_t (*getValue)(mixsrc_t i);
+};
+
+// Sources ranges, in the MixSources order
+const SourceRange sourceRanges[] = {
+  { MIXSRC_NONE, getZeroSourceValue },
+  { MIXSRC_LAST_INPUT, getInputSourceValue },
 #if defined(LUA_INPUTS)
-  else if (i <= MIXSRC_LAST_POT+NUM_MOUSE_ANALOGS) {
-    return calibratedAnalogs[i-MIXSRC_Rud];
+  { MIXSRC_LAST_LUA, getLuaSourceValue },
+#endif
+  { MIXSRC_LAST_POT+NUM_MOUSE_ANALOGS, getAnalogSourceValue },
+#if defined(ROTARY_ENCODERS)
+  { MIXSRC_LAST_ROTARY_ENCODER, getRotaryEncoderSourceValue },
+#endif
+  { MIXSRC_MAX-1, getZeroSourceValue },
+  { MIXSRC_MAX, getMaxSourceValue },
+  { MIXSRC_CYC3, getHeliSourceValue },
+  { MIXSRC_LAST_TRIM, getTrimSourceValue },
+  { MIXSRC_LAST_SWITCH, getSwitchSourceValue },
+  { MIXSRC_LAST_LOGICAL_SWITCH, getLogicalSwitchSourceValue },
+  { MIXSRC_LAST_TRAINER, getTrainerSourceValue },
+  { MIXSRC_LAST_CH, getChannelSourceValue },
+#if defined(GVARS)
+  { MIXSRC_LAST_GVAR, getGVarSourceValue },
+#else
+  { MIXSRC_LAST_GVAR, getZeroSourceValue },
+#endif
+  { MIXSRC_TX_VOLTAGE, getTxVoltageSourceValue },
+  { MIXSRC_FIRST_TIMER-1, getTxTimeSourceValue },
+  { MIXSRC_LAST_TIMER, getTimerSourceValue },
+  { MIXSRC_LAST_TELEM, getTelemetrySourceValue },
+};
+
+getvalue_t getValue(mixsrc_t i)
+{
+  if (i > MIXSRC_LAST_TELEM) {
+    return 0;
+  }
+
+  // binary search of the first range ending at or after i
+  uint8_t first = 0;
+  uint8_t last = DIM(sourceRanges) - 1;
+  while (first < last) {
+    uint8_t middle = (first + last) / 2;
+    if (sourceRanges[middle].last < i)
+      first = middle + 1;
+    else
+      last = middle;
   }
+  return sourceRanges[first].getValue(i);
+}
 #else
+getvalue_t getValue(mixsrc_t i)
+{
+  if (i == MIXSRC_NONE) {
+    return 0;
+  }
+
   else if (i>=MIXSRC_FIRST_STICK && i<=MIXSRC_LAST_POT+NUM_MOUSE_ANALOGS) {
     return calibratedAnalogs[i-MIXSRC_Rud];
   }
-#endif
 
 #if defined(PCBGRUVIN9X) || defined(PCBMEGA2560) || defined(ROTARY_ENCODERS)
   else if (i <= MIXSRC_LAST_ROTARY_ENCODER) {
@@ -385,17 +556,6 @@ getvalue_t getValue(mixsrc_t i)
     return calc1000toRESX((int16_t)8 * getTrimValue(mixerCurrentFlightMode, i-MIXSRC_FIRST_TRIM));
   }
 
-#if defined(PCBTARANIS) || defined(PCBHORUS)
-  else if ((i >= MIXSRC_FIRST_SWITCH) && (i <= MIXSRC_LAST_SWITCH)) {
-    mixsrc_t sw = i-MIXSRC_FIRST_SWITCH;
-    if (SWITCH_EXISTS(sw)) {
-      return (switchState(3*sw) ? -1024 : (switchState(3*sw+1) ? 0 : 1024));
-    }
-    else {
-      return 0;
-    }
-  }
-#else
   else if (i == MIXSRC_3POS) {
     return (getSwitch(SW_ID0+1) ? -1024 : (getSwitch(SW_ID1+1) ? 0 : 1024));
   }
@@ -403,7 +563,6 @@ getvalue_t getValue(mixsrc_t i)
   else if (i < MIXSRC_SW1) {
     return getSwitch(SWSRC_THR+i-MIXSRC_THR) ? 1024 : -1024;
   }
-#endif
 
   else if (i <= MIXSRC_LAST_LOGICAL_SWITCH) {
     return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH+i-MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
@@ -425,48 +584,14 @@ getvalue_t getValue(mixsrc_t i)
   }
 #endif
 
-#if defined(CPUARM)
-  else if (i == MIXSRC_TX_VOLTAGE) {
-    return g_vbat100mV;
-  }
-  else if (i < MIXSRC_FIRST_TIMER) {
-    // TX_TIME + SPARES
-#if defined(RTCLOCK)
-    return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
-#else
-    return 0;
-#endif
-  }
-  else if (i <= MIXSRC_LAST_TIMER) {
-    return timersStates[i-MIXSRC_FIRST_TIMER].val;
-  }
-#else
   else if (i == MIXSRC_FIRST_TELEM-1+TELEM_TX_VOLTAGE) {
     return g_vbat100mV;
   }
   else if (i <= MIXSRC_FIRST_TELEM-1+TELEM_TIMER2) {
     return timersStates[i-MIXSRC_FIRST_TELEM+1-TELEM_TIMER1].val;
   }
-#endif
 
-#if defined(CPUARM)
-  else if (i <= MIXSRC_LAST_TELEM) {
-    if(IS_FAI_FORBIDDEN(i)) {
-      return 0;
-    }
-    i -= MIXSRC_FIRST_TELEM;
-    div_t qr = div(i, 3);
-    TelemetryItem & telemetryItem = telemetryItems[qr.quot];
-    switch (qr.rem) {
-      case 1:
-        return telemetryItem.valueMin;
-      case 2:
-        return telemetryItem.valueMax;
-      default:
-        return telemetryItem.value;
-    }
-  }
-#elif defined(TELEMETRY_FRSKY)
+#if defined(TELEMETRY_FRSKY)
   else if (i==MIXSRC_FIRST_TELEM-1+TELEM_RSSI_TX) return telemetryData.rssi[1].value;
   else if (i==MIXSRC_FIRST_TELEM-1+TELEM_RSSI_RX) return telemetryData.rssi[0].value;
   else if (i==MIXSRC_FIRST_TELEM-1+TELEM_A1) return telemetryData.analog[TELEM_ANA_A1].value;
@@ -504,6 +629,7 @@ getvalue_t getValue(mixsrc_t i)
 #endif
   else return 0;
 }
+#endif
 
 void evalInputs(uint8_t mode)
 {
@@ -673,12 +799,195 @@ int getSourceTrimValue(int source, int stickValue=0)
 }
 #endif
 
+#if defined(CPUARM)
+MixerOp mixerPlan[MAX_MIXERS];
+uint8_t mixerPlanSize = 0;
+bool mixerPlanDirty = true;
+ACTIVE_PHASES_TYPE fadeChannelsModes = 0;
+bitfield_channels_t fadeChannels;
+
+void buildMixerPlan()
+{
+  // cleared first, so that a modification done while we are building is not lost
+  mixerPlanDirty = false;
+  fadeChannelsModes = 0;
+
+  uint8_t count = 0;
+
+  for (uint8_t i=0; i<MAX_MIXERS; i++) {
+    MixData * md = mixAddress(i);
+    mixsrc_t srcRaw = md->srcRaw;
+    if (srcRaw == 0) break; // end of list
+
+    MixerOp & op = mixerPlan[count++];
+    op.index = i;
+    op.destCh = md->destCh;
+    op.flags = 0;
+    op.srcIndex = 0;
+
+    if (i == 0 || md->destCh != (md-1)->destCh) {
+      op.flags |= MIXER_OP_FIRST_LINE;
+    }
+
+    if (srcRaw >= MIXSRC_FIRST_TRAINER && srcRaw <= MIXSRC_LAST_TRAINER) {
+      op.flags |= MIXER_OP_TRAINER;
+    }
+#if defined(LUA_MODEL_SCRIPTS)
+    else if (srcRaw >= MIXSRC_FIRST_LUA && srcRaw <= MIXSRC_LAST_LUA) {
+      op.flags |= MIXER_OP_LUA;
+      op.srcIndex = (srcRaw - MIXSRC_FIRST_LUA) / MAX_SCRIPT_OUTPUTS;
+    }
+#endif
+    else if (srcRaw >= MIXSRC_CH1 && srcRaw <= MIXSRC_LAST_CH && srcRaw - MIXSRC_CH1 != md->destCh) {
+      op.flags |= MIXER_OP_CHANNEL;
+      op.srcIndex = srcRaw - MIXSRC_CH1;
+    }
+
+    if (md->carryTrim == 0 && ((srcRaw >= MIXSRC_Rud && srcRaw <= MIXSRC_Ail) || (srcRaw >= MIXSRC_FIRST_INPUT && srcRaw <= MIXSRC_LAST_INPUT))) {
+      op.flags |= MIXER_OP_TRIM;
+    }
+
+#if defined(GVARS)
+    if (GV_IS_GV_VALUE(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE))
+      op.flags |= MIXER_OP_GVAR_WEIGHT;
+    if (GV_IS_GV_VALUE(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE))
+      op.flags |= MIXER_OP_GVAR_OFFSET;
+#endif
+
+    // values which are not GVARs don't depend on the flight mode
+    op.weight = calc100to256_16Bits(GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, 0));
+    op.offset = div_and_round(calc100toRESX_16Bits(GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, 0)), 10);
+  }
+
+  mixerPlanSize = count;
+}
+
+static bool isFlightModesMaskDependent(uint32_t flightModes, ACTIVE_PHASES_TYPE modes)
+{
+  // a line enabled in all or in none of the modes gives the same result
+  flightModes &= modes;
+  return flightModes != 0 && flightModes != modes;
+}
+
+static bool isSwitchFlightModeDependent(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  return (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH) ||
+         (swtch >= SWSRC_FIRST_FLIGHT_MODE && swtch <= SWSRC_LAST_FLIGHT_MODE);
+}
+
+static bool isSourceFlightModeDependent(mixsrc_t source)
+{
+  return (source >= MIXSRC_FIRST_HELI && source <= MIXSRC_LAST_TRIM) ||
+         (source >= MIXSRC_FIRST_LOGICAL_SWITCH && source <= MIXSRC_LAST_LOGICAL_SWITCH) ||
+         (source >= MIXSRC_FIRST_GVAR && source <= MIXSRC_LAST_GVAR);
+}
+
+static bool isCurveFlightModeDependent(const CurveRef & curve)
+{
+#if defined(GVARS)
+  return (curve.type == CURVE_REF_DIFF || curve.type == CURVE_REF_EXPO) && GV_IS_GV_VALUE(curve.value, -100, 100);
+#else
+  return false;
+#endif
+}
+
+// The trims are shared when each one adds the same flight modes values in all the given flight modes
+static bool areTrimsShared(ACTIVE_PHASES_TYPE modes)
+{
+  if (trimFlightModesDirty) {
+    buildTrimFlightModes();
+  }
+  for (uint8_t idx=0; idx<NUM_TRIMS; idx++) {
+    int owners = -1;
+    for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
+      if (modes & ((ACTIVE_PHASES_TYPE)1 << p)) {
+        if (owners >= 0 && trimFlightModes[p][idx] != owners)
+          return false;
+        owners = trimFlightModes[p][idx];
+      }
+    }
+  }
+  return true;
+}
+
+/**
+  @brief Returns the channels which may have a different value in the given flight modes
+
+  The other channels don't need to be evaluated again for each fading flight mode.
+  This errs on the safe side: any GVAR, logical switch or not shared trim makes the
+  channel depend on the flight mode.
+*/
+bitfield_channels_t getFlightModesDependentChannels(ACTIVE_PHASES_TYPE modes)
+{
+  bool trimsShared = areTrimsShared(modes);
+
+  uint32_t inputs = 0;
+  for (uint8_t i=0; i<MAX_EXPOS; i++) {
+    ExpoData * ed = expoAddress(i);
+    if (!EXPO_VALID(ed)) break; // end of list
+    bool dependent = isFlightModesMaskDependent(ed->flightModes, modes) ||
+                     isSwitchFlightModeDependent(ed->swtch) ||
+                     isCurveFlightModeDependent(ed->curve) ||
+                     (ed->srcRaw >= MIXSRC_FIRST_INPUT && ed->srcRaw <= MIXSRC_LAST_INPUT) ||
+                     (ed->srcRaw >= MIXSRC_CH1 && ed->srcRaw <= MIXSRC_LAST_CH) ||
+                     isSourceFlightModeDependent(ed->srcRaw);
+#if defined(GVARS)
+    dependent = dependent || GV_IS_GV_VALUE(ed->weight, MIN_EXPO_WEIGHT, 100) || GV_IS_GV_VALUE(ed->offset, -100, 100);
+#endif
+    if (dependent) {
+      inputs |= (uint32_t)1 << ed->chn;
+    }
+  }
+
+  bitfield_channels_t result = 0;
+  for (uint8_t k=0; k<mixerPlanSize; k++) {
+    const MixerOp & op = mixerPlan[k];
+    MixData * md = mixAddress(op.index);
+    mixsrc_t srcRaw = md->srcRaw;
+    if (isFlightModesMaskDependent(md->flightModes, modes) ||
+        isSwitchFlightModeDependent(md->swtch) ||
+        isCurveFlightModeDependent(md->curve) ||
+        isSourceFlightModeDependent(srcRaw) ||
+        (op.flags & (MIXER_OP_GVAR_WEIGHT | MIXER_OP_GVAR_OFFSET)) ||
+        ((op.flags & MIXER_OP_TRIM) && !trimsShared) ||
+        (srcRaw >= MIXSRC_FIRST_INPUT && srcRaw <= MIXSRC_LAST_INPUT && (inputs & ((uint32_t)1 << (srcRaw - MIXSRC_FIRST_INPUT))))) {
+      result |= (bitfield_channels_t)1 << op.destCh;
+    }
+  }
+
+  // channels using dependent channels as source
+  bitfield_channels_t previous;
+  do {
+    previous = result;
+    for (uint8_t k=0; k<mixerPlanSize; k++) {
+      const MixerOp & op = mixerPlan[k];
+      if ((op.flags & MIXER_OP_CHANNEL) && (result & ((bitfield_channels_t)1 << op.srcIndex))) {
+        result |= (bitfield_channels_t)1 << op.destCh;
+      }
+    }
+  } while (result != previous);
+
+  return result;
+}
+#endif
+
 uint8_t mixerCurrentFlightMode;
+#if defined(CPUARM)
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms, bitfield_channels_t channels)
+#else
 void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+#endif
 {
+  BENCHMARK_STAGE_START(benchmarkStageInputs);
   evalInputs(mode);
+  BENCHMARK_STAGE_STOP(benchmarkStageInputs);
 
-  if (tick10ms) evalLogicalSwitches(mode==e_perout_mode_normal);
+  if (tick10ms) {
+    BENCHMARK_STAGE_START(benchmarkStageLogicalSwitches);
+    evalLogicalSwitches(mode==e_perout_mode_normal);
+    BENCHMARK_STAGE_STOP(benchmarkStageLogicalSwitches);
+  }
 
 #if defined(MODULE_ALWAYS_SEND_PULSES)
   checkStartupWarnings();
@@ -764,19 +1073,51 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
   }
 #endif
 
+#if defined(CPUARM)
+  // channels which are not evaluated keep their current value
+  if (channels == (bitfield_channels_t)-1)
+#endif
   memclear(chans, sizeof(chans));        // All outputs to 0
 
   //========== MIXER LOOP ===============
   uint8_t lv_mixWarning = 0;
 
+#if defined(CPUARM)
+  if (mixerPlanDirty) {
+    buildMixerPlan();
+  }
+#endif
+
   uint8_t pass = 0;
 
+#if defined(CPUARM)
+  bitfield_channels_t dirtyChannels = channels; // all dirty when mixer starts
+#else
   bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
+#endif
 
   do {
 
     bitfield_channels_t passDirtyChannels = 0;
 
+#if defined(CPUARM)
+    for (uint8_t k=0; k<mixerPlanSize; k++) {
+      const MixerOp * op = &mixerPlan[k];
+      uint8_t i = op->index;
+
+#if defined(BOLD_FONT)
+      if (mode==e_perout_mode_normal && pass==0) swOn[i].activeMix = 0;
+#endif
+
+      if (!(dirtyChannels & ((bitfield_channels_t)1 << op->destCh))) continue;
+
+      MixData *md = mixAddress(i);
+
+      // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
+      if (op->flags & MIXER_OP_FIRST_LINE) {
+        chans[op->destCh] = 0;
+      }
+#else
     for (uint8_t i=0; i<MAX_MIXERS; i++) {
 
 #if defined(BOLD_FONT)
@@ -795,6 +1136,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       if (i == 0 || md->destCh != (md-1)->destCh) {
         chans[md->destCh] = 0;
       }
+#endif
 
       //========== FLIGHT MODE && SWITCH =====
       bool mixCondition = (md->flightModes != 0 || md->swtch);
@@ -802,17 +1144,20 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
 #define MIXER_LINE_DISABLE()   (mixCondition = true, mixEnabled = 0)
 
+#if defined(CPUARM)
+      if (mixEnabled && (op->flags & MIXER_OP_TRAINER) && !IS_TRAINER_INPUT_VALID()) {
+        MIXER_LINE_DISABLE();
+      }
+#else
       if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_TRAINER && md->srcRaw <= MIXSRC_LAST_TRAINER && !IS_TRAINER_INPUT_VALID()) {
         MIXER_LINE_DISABLE();
       }
+#endif
 
 #if defined(LUA_MODEL_SCRIPTS)
       // disable mixer if Lua script is used as source and script was killed
-      if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_LUA && md->srcRaw <= MIXSRC_LAST_LUA) {
-        div_t qr = div(md->srcRaw-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-        if (scriptInternalData[qr.quot].state != SCRIPT_OK) {
-          MIXER_LINE_DISABLE();
-        }
+      if (mixEnabled && (op->flags & MIXER_OP_LUA) && scriptInternalData[op->srcIndex].state != SCRIPT_OK) {
+        MIXER_LINE_DISABLE();
       }
 #endif
 
@@ -843,6 +1188,16 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
         else
 #endif
         {
+#if defined(CPUARM)
+          v = getValue(md->srcRaw);
+          if (op->flags & MIXER_OP_CHANNEL) {
+            uint8_t srcCh = op->srcIndex;
+            if (dirtyChannels & ((bitfield_channels_t)1 << srcCh) & (passDirtyChannels|~(((bitfield_channels_t) 1 << op->destCh)-1)))
+              passDirtyChannels |= (bitfield_channels_t) 1 << op->destCh;
+            if (srcCh < op->destCh || pass > 0)
+              v = chans[srcCh] >> 8;
+          }
+#else
           mixsrc_t srcRaw = MIXSRC_Rud + stickIndex;
           v = getValue(srcRaw);
           srcRaw -= MIXSRC_CH1;
@@ -852,6 +1207,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
             if (srcRaw < md->destCh || pass > 0)
               v = chans[srcRaw] >> 8;
           }
+#endif
         }
         if (!mixCondition) {
           mixEnabled = v >> DELAY_POS_SHIFT;
@@ -906,7 +1262,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
         //========== TRIMS ================
         if (!(mode & e_perout_mode_notrims)) {
 #if defined(VIRTUAL_INPUTS)
-          if (md->carryTrim == 0) {
+          if (op->flags & MIXER_OP_TRIM) {
             v += getSourceTrimValue(md->srcRaw, v);
           }
 #else
@@ -929,8 +1285,11 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       }
 
 #if defined(CPUARM)
-      int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-      weight = calc100to256_16Bits(weight);
+      int32_t weight = op->weight;
+      if (op->flags & MIXER_OP_GVAR_WEIGHT) {
+        weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+        weight = calc100to256_16Bits(weight);
+      }
 #else
       // saves 12 bytes code if done here and not together with weight; unknown reason
       int16_t weight = GET_GVAR(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
@@ -997,8 +1356,13 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       //========== OFFSET / AFTER ===============
       if (apply_offset_and_curve) {
 #if defined(CPUARM)
-        int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-        if (offset) dv += div_and_round(calc100toRESX_16Bits(offset), 10) << 8;
+        if (op->flags & MIXER_OP_GVAR_OFFSET) {
+          int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+          if (offset) dv += div_and_round(calc100toRESX_16Bits(offset), 10) << 8;
+        }
+        else if (op->offset) {
+          dv += op->offset << 8;
+        }
 #else
         int16_t offset = GET_GVAR(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
         if (offset) dv += int32_t(calc100toRESX_16Bits(offset)) << 8;
@@ -1021,7 +1385,11 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       }
 #endif
 
+#if defined(CPUARM)
+      int32_t * ptr = &chans[op->destCh]; // Save calculating address several times
+#else
       int32_t * ptr = &chans[md->destCh]; // Save calculating address several times
+#endif
 
       switch (md->mltpx) {
         case MLTPX_REP:
@@ -1118,6 +1486,11 @@ void evalMixes(uint8_t tick10ms)
 
   LS_RECURSIVE_EVALUATION_RESET();
 
+#if defined(CPUARM)
+  // the curves edited since the last cycle get their tables refilled here
+  updateCurveLuts();
+#endif
+
   uint8_t fm = getFlightMode();
 
   if (lastFlightMode != fm) {
@@ -1161,6 +1534,44 @@ void evalMixes(uint8_t tick10ms)
 #endif
 
   int32_t weight = 0;
+#if defined(CPUARM)
+  if (flightModesFade) {
+    DEBUG_TIMER_START(debugTimerMixFade);
+    if (mixerPlanDirty) {
+      buildMixerPlan();
+    }
+    if (fadeChannelsModes != flightModesFade) {
+      fadeChannelsModes = flightModesFade;
+      fadeChannels = getFlightModesDependentChannels(flightModesFade);
+    }
+
+    // the current flight mode is evaluated first, the other fading flight modes
+    // only evaluate again the channels which depend on the flight mode
+    int32_t activeChans[MAX_OUTPUT_CHANNELS];
+    mixerCurrentFlightMode = fm;
+    evalFlightModeMixes(e_perout_mode_normal, tick10ms);
+    memcpy(activeChans, chans, sizeof(activeChans));
+    memclear(sum_chans512, sizeof(sum_chans512));
+    for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
+      if (flightModesFade & ((ACTIVE_PHASES_TYPE)1 << p)) {
+        const int32_t * values = activeChans;
+        if (p != fm && fadeChannels) {
+          mixerCurrentFlightMode = p;
+          memcpy(chans, activeChans, sizeof(chans));
+          evalFlightModeMixes(e_perout_mode_inactive_flight_mode, 0, fadeChannels);
+          values = chans;
+        }
+        for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
+          sum_chans512[i] += (values[i] >> 4) * fp_act[p];
+        weight += fp_act[p];
+      }
+    }
+    assert(weight);
+    memcpy(chans, activeChans, sizeof(chans));
+    mixerCurrentFlightMode = fm;
+    DEBUG_TIMER_STOP(debugTimerMixFade);
+  }
+#else
   if (flightModesFade) {
     memclear(sum_chans512, sizeof(sum_chans512));
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
@@ -1177,6 +1588,7 @@ void evalMixes(uint8_t tick10ms)
     assert(weight);
     mixerCurrentFlightMode = fm;
   }
+#endif
   else {
     mixerCurrentFlightMode = fm;
     evalFlightModeMixes(e_perout_mode_normal, tick10ms);
@@ -1190,6 +1602,7 @@ void evalMixes(uint8_t tick10ms)
     requiredSpeakerVolume = g_eeGeneral.speakerVolume + VOLUME_LEVEL_DEF;
 #endif
 
+    BENCHMARK_STAGE_START(benchmarkStageFunctions);
 #if defined(CPUARM)
     if (!g_model.noGlobalFunctions) {
       evalFunctions(g_eeGeneral.customFn, globalFunctionsContext);
@@ -1198,9 +1611,13 @@ void evalMixes(uint8_t tick10ms)
 #else
     evalFunctions();
 #endif
+    BENCHMARK_STAGE_STOP(benchmarkStageFunctions);
   }
 
+  LATENCY_MEASURE(latencyMixer);
+
   //========== LIMITS ===============
+  BENCHMARK_STAGE_START(benchmarkStageLimits);
   for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
     // chans[i] holds data from mixer.   chans[i] = v*weight => 1024*256
     // later we multiply by the limit (up to 100) and then we need to normalize
@@ -1221,6 +1638,9 @@ void evalMixes(uint8_t tick10ms)
     channelOutputs[i] = value;  // copy consistent word to int-level
     sei();
   }
+  BENCHMARK_STAGE_STOP(benchmarkStageLimits);
+
+  LATENCY_MEASURE(latencyOutputs);
 
   if (tick10ms && flightModesFade) {
     uint16_t tick_delta = delta * tick10ms;
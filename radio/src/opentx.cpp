@@ -644,10 +644,14 @@ trim_t getRawTrimValue(uint8_t phase, uint8_t idx)
 #endif
 }
 
-int getTrimValue(uint8_t phase, uint8_t idx)
-{
 #if defined(CPUARM)
-  int result = 0;
+uint16_t trimFlightModes[MAX_FLIGHT_MODES][NUM_TRIMS];
+bool trimFlightModesDirty = true;
+
+// Returns the flight modes whose trim values are added to get the trim of the given flight mode
+static uint16_t resolveTrimFlightModes(uint8_t phase, uint8_t idx)
+{
+  uint16_t result = 0;
   for (uint8_t i=0; i<MAX_FLIGHT_MODES; i++) {
     trim_t v = getRawTrimValue(phase, idx);
     if (v.mode == TRIM_MODE_NONE) {
@@ -656,17 +660,46 @@ int getTrimValue(uint8_t phase, uint8_t idx)
     else {
       unsigned int p = v.mode >> 1;
       if (p == phase || phase == 0) {
-        return result + v.value;
+        return result | (1 << phase);
       }
       else {
-        phase = p;
         if (v.mode % 2 != 0) {
-          result += v.value;
+          result |= (1 << phase);
         }
+        phase = p;
       }
     }
   }
   return 0;
+}
+
+void buildTrimFlightModes()
+{
+  // cleared first, so that a modification done while we are building is not lost
+  trimFlightModesDirty = false;
+
+  for (uint8_t phase=0; phase<MAX_FLIGHT_MODES; phase++) {
+    for (uint8_t idx=0; idx<NUM_TRIMS; idx++) {
+      trimFlightModes[phase][idx] = resolveTrimFlightModes(phase, idx);
+    }
+  }
+}
+#endif
+
+int getTrimValue(uint8_t phase, uint8_t idx)
+{
+#if defined(CPUARM)
+  if (trimFlightModesDirty) {
+    buildTrimFlightModes();
+  }
+  int result = 0;
+  uint16_t modes = trimFlightModes[phase][idx];
+  for (uint8_t p=0; modes; p++, modes >>= 1) {
+    if (modes & 1) {
+      result += g_model.flightModeData[p].trim[idx].value;
+    }
+  }
+  return result;
 #else
   return getRawTrimValue(getTrimFlightMode(phase, idx), idx);
 #endif
@@ -692,7 +725,8 @@ bool setTrimValue(uint8_t phase, uint8_t idx, int trim)
       break;
     }
   }
-  storageDirty(EE_MODEL);
+  // only the value is changed, the trims flight modes table is still right
+  storageDirtyValue(EE_MODEL);
   return true;
 }
 #else
@@ -1107,6 +1141,13 @@ void checkRSSIAlarmsDisabled()
     ALERT(STR_RSSIALARM_WARN, STR_NO_RSSIALARM, AU_ERROR);
   }
 }
+
+void checkLogicalSwitchesLoop()
+{
+  if (lswLoopIndex >= 0) {
+    ALERT(STR_MENULOGICALSWITCHES, STR_LSW_LOOP, AU_ERROR);
+  }
+}
 #endif
 
 #if defined(GUI)
@@ -1127,6 +1168,7 @@ void checkAll()
 #endif
 #if defined(CPUARM)
   checkRSSIAlarmsDisabled();
+  checkLogicalSwitchesLoop();
 #endif
 
 #if defined(SDCARD) && defined(CPUARM)
@@ -1745,13 +1787,19 @@ void doMixerCalculations()
   lastTMR = tmr10ms;
 
   DEBUG_TIMER_START(debugTimerGetAdc);
+  LATENCY_SAMPLE();
   getADC();
+  LATENCY_MEASURE(latencyAdc);
   DEBUG_TIMER_STOP(debugTimerGetAdc);
 
   DEBUG_TIMER_START(debugTimerGetSwitches);
   getSwitchesPosition(!s_mixer_first_run_done);
   DEBUG_TIMER_STOP(debugTimerGetSwitches);
 
+#if defined(INPUTS_RECORDER)
+  recordMixerCycle();
+#endif
+
 #if defined(PCBSKY9X) && !defined(REVA) && !defined(SIMU)
   Current_analogue = (Current_analogue*31 + s_anaFilt[8] ) >> 5 ;
   if (Current_analogue > Current_max)
@@ -693,11 +693,49 @@ extern uint8_t flightModeTransitionLast;
   #define availableMemory() ((unsigned int)((unsigned char *)&_heap_end - heap))
 #endif
 
+#if defined(CPUARM)
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms, bitfield_channels_t channels=(bitfield_channels_t)-1);
+#else
 void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms);
+#endif
 void evalMixes(uint8_t tick10ms);
 void doMixerCalculations();
 void scheduleNextMixerCalculation(uint8_t module, uint16_t period_ms);
 
+#if defined(CPUARM)
+// The mixer plan is the list of the mixer lines, resolved once when the model
+// is loaded or modified, so that the mixer loop doesn't have to decode the
+// MixData structures at each cycle
+enum MixerOpFlags {
+  MIXER_OP_FIRST_LINE = 0x01,     // first line of the destination channel
+  MIXER_OP_CHANNEL = 0x02,        // source is another channel (srcIndex)
+  MIXER_OP_TRAINER = 0x04,        // source is a trainer input
+  MIXER_OP_LUA = 0x08,            // source is a Lua script output (srcIndex is the script)
+  MIXER_OP_TRIM = 0x10,           // source trim has to be added
+  MIXER_OP_GVAR_WEIGHT = 0x20,    // weight has to be read from a GVAR
+  MIXER_OP_GVAR_OFFSET = 0x40,    // offset has to be read from a GVAR
+};
+
+struct MixerOp {
+  uint8_t index;
+  uint8_t destCh;
+  uint8_t flags;
+  uint8_t srcIndex;
+  int16_t weight;                 // already converted with calc100to256_16Bits()
+  int16_t offset;                 // already converted with calc100toRESX_16Bits()
+};
+
+extern MixerOp mixerPlan[MAX_MIXERS];
+extern uint8_t mixerPlanSize;
+extern bool mixerPlanDirty;
+
+void buildMixerPlan();
+inline void invalidateMixerPlan()
+{
+  mixerPlanDirty = true;
+}
+#endif
+
 #if defined(CPUARM)
   void checkTrims();
 #endif
@@ -717,6 +755,13 @@ void logicalSwitchesTimerTick();
 void logicalSwitchesReset();
 
 #if defined(CPUARM)
+  extern bool lswOrderDirty;
+  extern int8_t lswLoopIndex;
+  void buildLogicalSwitchesOrder();
+  inline void invalidateLogicalSwitchesOrder()
+  {
+    lswOrderDirty = true;
+  }
   void evalLogicalSwitches(bool isCurrentPhase=true);
   void logicalSwitchesCopyState(uint8_t src, uint8_t dst);
   #define LS_RECURSIVE_EVALUATION_RESET()
@@ -769,6 +814,18 @@ swsrc_t getMovedSwitch();
 trim_t getRawTrimValue(uint8_t phase, uint8_t idx);
 int getTrimValue(uint8_t phase, uint8_t idx);
 
+#if defined(CPUARM)
+  // Flight modes whose trim values are added, for each flight mode and trim.
+  // Rebuilt on first access after the model has been changed
+  extern uint16_t trimFlightModes[MAX_FLIGHT_MODES][NUM_TRIMS];
+  extern bool trimFlightModesDirty;
+  void buildTrimFlightModes();
+  inline void invalidateTrimFlightModes()
+  {
+    trimFlightModesDirty = true;
+  }
+#endif
+
 #if defined(CPUARM)
   bool setTrimValue(uint8_t phase, uint8_t idx, int trim);
 #else
@@ -1113,6 +1170,19 @@ int applyCurrentCurve(int x);
 int8_t getCurveX(int noPoints, int point);
 void resetCustomCurveX(int8_t * points, int noPoints);
 bool moveCurve(uint8_t index, int8_t shift); // TODO bool?
+#define CURVE_LUT_POINTS               257
+#define CURVE_LUT_STEP                 (2*RESX / (CURVE_LUT_POINTS-1))
+#if defined(PCBHORUS)
+  #define MAX_CURVE_LUTS               MAX_CURVES
+#else
+  #define MAX_CURVE_LUTS               8
+#endif
+extern int8_t curveLutSlot[MAX_CURVES];
+void resetCurveLuts();
+void invalidateCurveLut(uint8_t idx);
+void updateCurveLuts();
+int applyCurveLut(int x, int8_t slot);
+int16_t hermite_spline(int16_t x, uint8_t idx);
 #else
 struct CurveInfo {
   int8_t * crv;
@@ -1214,6 +1284,10 @@ PACK(typedef struct {
 extern SwOn   swOn[MAX_MIXERS];
 extern int24_t act[MAX_MIXERS];
 
+#if defined(CPUARM)
+bitfield_channels_t getFlightModesDependentChannels(ACTIVE_PHASES_TYPE modes);
+#endif
+
 #if defined(BOLD_FONT)
   inline bool isExpoActive(uint8_t expo)
   {
@@ -1255,6 +1329,9 @@ enum FunctionsActive {
   FUNCTION_BACKGND_MUSIC,
   FUNCTION_BACKGND_MUSIC_PAUSE,
 #endif
+#if defined(CPUARM) && defined(SDCARD)
+  FUNCTION_LOGS_FAST,
+#endif
 };
 
 #define VARIO_FREQUENCY_ZERO   700/*Hz*/
@@ -1284,10 +1361,7 @@ void evalFunctions();
 
 #include "telemetry/telemetry.h"
 
-#if defined(CPUARM)
-uint8_t crc8(const uint8_t * ptr, uint32_t len);
-uint16_t crc16(const uint8_t * ptr, uint32_t len);
-#endif
+#include "crc.h"
 
 #define PLAY_REPEAT(x)            (x)                 /* Range 0 to 15 */
 #define PLAY_NOW                  0x10
@@ -1422,6 +1496,10 @@ enum AUDIO_SOUNDS {
 #include "sdcard.h"
 #endif
 
+#if defined(INPUTS_RECORDER)
+#include "recorder.h"
+#endif
+
 #if defined(RTCLOCK)
 #include "rtc.h"
 #endif
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _CHANNELS_PACKER_H_
+#define _CHANNELS_PACKER_H_
+
+#include <inttypes.h>
+#include <string.h>
+
+// Channels packed on BITS bits each, LSB first, as in the CRSF, SBUS and MULTI
+// frames. scale(index) returns the value of each channel, already limited to
+// BITS bits. The bits are accumulated in a 32 bits word, written as a whole
+// (little endian targets), the last bytes being written one by one
+template <unsigned BITS, unsigned COUNT>
+class ChannelsPacker
+{
+  static_assert(BITS > 0 && BITS < 32, "Channels must be packed on less than 32 bits!");
+
+  public:
+    static const unsigned SIZE = (BITS * COUNT + 7) / 8;
+
+    template <class SCALE>
+    static uint8_t * pack(uint8_t * frame, SCALE scale)
+    {
+      uint32_t bits = 0;
+      uint32_t count = 0;
+      for (unsigned i=0; i<COUNT; i++) {
+        uint32_t value = scale(i);
+        bits |= value << count;
+        count += BITS;
+        if (count >= 32) {
+          memcpy(frame, &bits, sizeof(bits));
+          frame += sizeof(bits);
+          count -= 32;
+          bits = value >> (BITS - count);
+        }
+      }
+      for (; count > 0; count -= (count > 8 ? 8 : count)) {
+        *frame++ = bits;
+        bits >>= 8;
+      }
+      return frame;
+    }
+};
+
+// Channels outputs ([-1024:+1024] for [-100%:+100%]) scaled to 80% around
+// center and limited to [0:max]
+inline uint32_t scaleChannelOutput(int value, int center, int max)
+{
+  return limit(0, center + value * 4 / 5, max);
+}
+
+#endif // _CHANNELS_PACKER_H_
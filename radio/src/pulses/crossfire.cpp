@@ -19,6 +19,7 @@
  */
 
 #include "opentx.h"
+#include "channels_packer.h"
 
 #define CROSSFIRE_CH_CENTER         0x3E0
 #define CROSSFIRE_CH_BITS           11
@@ -31,18 +32,9 @@ uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses)
   *buf++ = 24; // 1(ID) + 22 + 1(CRC)
   uint8_t * crc_start = buf;
   *buf++ = CHANNELS_ID;
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
-    uint32_t val = limit(0, CROSSFIRE_CH_CENTER + (((pulses[i]) * 4) / 5), 2*CROSSFIRE_CH_CENTER);
-    bits |= val << bitsavailable;
-    bitsavailable += CROSSFIRE_CH_BITS;
-    while (bitsavailable >= 8) {
-      *buf++ = bits;
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
-  }
+  buf = ChannelsPacker<CROSSFIRE_CH_BITS, CROSSFIRE_CHANNELS_COUNT>::pack(buf, [=](unsigned i) {
+    return scaleChannelOutput(pulses[i], CROSSFIRE_CH_CENTER, 2*CROSSFIRE_CH_CENTER);
+  });
   *buf++ = crc8(crc_start, 23);
   return buf - frame;
 }
@@ -19,6 +19,7 @@
  */
 
 #include "opentx.h"
+#include "channels_packer.h"
 
 // for the  MULTI protocol definition
 // see https://github.com/pascallanger/DIY-Multiprotocol-TX-Module
@@ -31,6 +32,8 @@
 #define MULTI_CHANS                         16
 #define MULTI_CHAN_BITS                     11
 
+typedef ChannelsPacker<MULTI_CHAN_BITS, MULTI_CHANS> MultiChannelsPacker;
+
 static void sendFrameProtocolHeader(uint8_t port, bool failsafe);
 
 void sendChannels(uint8_t port);
@@ -51,14 +54,19 @@ static void sendSetupFrame()
   sendByteSbus(config);
 }
 
+static void sendChannelsBytes(const uint8_t * channels)
+{
+  for (unsigned i=0; i<MultiChannelsPacker::SIZE; i++) {
+    sendByteSbus(channels[i]);
+  }
+}
+
 static void sendFailsafeChannels(uint8_t port)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  uint8_t channels[MultiChannelsPacker::SIZE];
 
-  for (int i = 0; i < MULTI_CHANS; i++) {
+  MultiChannelsPacker::pack(channels, [=](unsigned i) -> uint32_t {
     int16_t failsafeValue = g_model.moduleData[port].failsafeChannels[i];
-    int pulseValue;
     if (g_model.moduleData[port].failsafeMode == FAILSAFE_HOLD)
       failsafeValue = FAILSAFE_CHANNEL_HOLD;
 
@@ -66,24 +74,18 @@ static void sendFailsafeChannels(uint8_t port)
       failsafeValue = FAILSAFE_CHANNEL_NOPULSE;
 
     if (failsafeValue == FAILSAFE_CHANNEL_HOLD) {
-      pulseValue = 0;
+      return 0;
     }
     else if (failsafeValue == FAILSAFE_CHANNEL_NOPULSE) {
-      pulseValue = 2047;
+      return 2047;
     }
     else {
       failsafeValue += 2 * PPM_CH_CENTER(g_model.moduleData[port].channelsStart + i) - 2 * PPM_CENTER;
-      pulseValue = limit(1, (failsafeValue * 800 / 1000) + 1024, 2047);
+      return limit(1, (failsafeValue * 800 / 1000) + 1024, 2047);
     }
+  });
 
-    bits |= pulseValue << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendByteSbus((uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
-  }
+  sendChannelsBytes(channels);
 }
 
 void setupPulsesMultimodule(uint8_t port)
@@ -119,28 +121,17 @@ void setupPulsesMultimodule(uint8_t port)
 
 void sendChannels(uint8_t port)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  uint8_t channels[MultiChannelsPacker::SIZE];
 
   // byte 4-25, channels 0..2047
   // Range for pulses (channelsOutputs) is [-1024:+1024] for [-100%;100%]
   // Multi uses [204;1843] as [-100%;100%]
-  for (int i = 0; i < MULTI_CHANS; i++) {
+  MultiChannelsPacker::pack(channels, [=](unsigned i) {
     int channel = g_model.moduleData[port].channelsStart + i;
-    int value = channelOutputs[channel] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER;
-
-    // Scale to 80%
-    value = value * 800 / 1000 + 1024;
-    value = limit(0, value, 2047);
-
-    bits |= value << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendByteSbus((uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
-  }
+    return scaleChannelOutput(channelOutputs[channel] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER, 1024, 2047);
+  });
+
+  sendChannelsBytes(channels);
 }
 
 void sendFrameProtocolHeader(uint8_t port, bool failsafe)
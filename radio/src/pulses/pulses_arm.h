@@ -165,7 +165,6 @@ union TrainerPulsesData {
 };
 
 extern TrainerPulsesData trainerPulsesData;
-extern const uint16_t CRCTable[];
 
 void setupPulses(uint8_t port);
 void setupPulsesDSM2(uint8_t port);
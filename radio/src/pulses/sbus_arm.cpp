@@ -19,6 +19,7 @@
  */
 
 #include "opentx.h"
+#include "channels_packer.h"
 
 
 #define BITLEN_SBUS          (10*2) // 100000 Baud => 10uS per bit
@@ -122,21 +123,14 @@ void setupPulsesSbus(uint8_t port)
   // Sync Byte
   sendByteSbus(SBUS_FRAME_BEGIN_BYTE);
 
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-
   // byte 1-22, channels 0..2047, limits not really clear (B
-  for (int i=0; i<SBUS_NORMAL_CHANS; i++) {
-    int value = getChannelValue(port, i);
-
-    value =  value*8/10 + SBUS_CHAN_CENTER;
-    bits |= limit(0, value, 2047) << bitsavailable;
-    bitsavailable += SBUS_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendByteSbus((uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+  typedef ChannelsPacker<SBUS_CHAN_BITS, SBUS_NORMAL_CHANS> SbusChannelsPacker;
+  uint8_t channels[SbusChannelsPacker::SIZE];
+  SbusChannelsPacker::pack(channels, [=](unsigned i) {
+    return scaleChannelOutput(getChannelValue(port, i), SBUS_CHAN_CENTER, 2047);
+  });
+  for (unsigned i=0; i<sizeof(channels); i++) {
+    sendByteSbus(channels[i]);
   }
 
   // flags
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+
+static_assert(sizeof(trim_t) == sizeof(uint16_t), "trim_t must fit in a record word");
+
+static int16_t recordAnalogValue(uint8_t index)
+{
+  int16_t v = anaIn(index);
+#if !defined(SIMU)
+  // same normalization as evalInputs(), the simulator analogs are calibrated
+  if (!IS_POT_MULTIPOS(index)) {
+    CalibData * calib = &g_eeGeneral.calib[index];
+    v -= calib->mid;
+    v = v * (int32_t) RESX / (max((int16_t) 100, (v > 0 ? calib->spanPos : calib->spanNeg)));
+  }
+#endif
+  return v;
+}
+
+void recordCapture(RecordSnapshot & snapshot)
+{
+  uint16_t * words = snapshot.words;
+
+  for (uint8_t i=0; i<RECORD_ANALOGS_COUNT; i++) {
+    words[RECORD_OFFSET_ANALOGS+i] = recordAnalogValue(i);
+  }
+
+  // raw switches states, the switches delays are applied again when replayed
+  memclear(&words[RECORD_OFFSET_SWITCHES], RECORD_SWITCHES_WORDS*sizeof(uint16_t));
+  for (uint8_t i=0; i<NUM_SWITCHES; i++) {
+    uint8_t sw = SW_SA0 + 3*i;
+    uint16_t state = (switchState(sw) ? 0 : (switchState(sw+2) ? 2 : 1));
+    words[RECORD_OFFSET_SWITCHES + i/8] |= state << (2*(i%8));
+  }
+
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    memcpy(&words[RECORD_OFFSET_TRIMS+fm*NUM_TRIMS], g_model.flightModeData[fm].trim, NUM_TRIMS*sizeof(uint16_t));
+  }
+
+  memcpy(&words[RECORD_OFFSET_TRAINER], ppmInput, MAX_TRAINER_CHANNELS*sizeof(uint16_t));
+  words[RECORD_OFFSET_TRAINER+MAX_TRAINER_CHANNELS] = ppmInputValidityTimer;
+
+  for (uint8_t i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    TelemetryItem & item = telemetryItems[i];
+    uint16_t * sensor = &words[RECORD_OFFSET_TELEMETRY+3*i];
+    sensor[0] = item.value;
+    sensor[1] = (uint32_t)item.value >> 16;
+    sensor[2] = (item.hasReceiveTime() ? item.getDelaySinceLastValue() : item.lastReceived);
+  }
+}
+
+#if defined(SIMU)
+void recordApply(const RecordSnapshot & snapshot)
+{
+  const uint16_t * words = snapshot.words;
+
+  for (uint8_t i=0; i<NUM_SWITCHES; i++) {
+    uint8_t state = (words[RECORD_OFFSET_SWITCHES + i/8] >> (2*(i%8))) & 0x03;
+    simuSetSwitch(i, state - 1);
+  }
+
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    memcpy(g_model.flightModeData[fm].trim, &words[RECORD_OFFSET_TRIMS+fm*NUM_TRIMS], NUM_TRIMS*sizeof(uint16_t));
+  }
+  invalidateTrimFlightModes();
+
+  memcpy(ppmInput, &words[RECORD_OFFSET_TRAINER], MAX_TRAINER_CHANNELS*sizeof(uint16_t));
+  ppmInputValidityTimer = words[RECORD_OFFSET_TRAINER+MAX_TRAINER_CHANNELS];
+
+  for (uint8_t i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    TelemetryItem & item = telemetryItems[i];
+    const uint16_t * sensor = &words[RECORD_OFFSET_TELEMETRY+3*i];
+    item.value = sensor[0] | ((uint32_t)sensor[1] << 16);
+    if (sensor[2] < TELEMETRY_VALUE_TIMER_CYCLE)
+      item.lastReceived = (TelemetryItem::now() - sensor[2]) & (TELEMETRY_VALUE_TIMER_CYCLE - 1);
+    else
+      item.lastReceived = sensor[2];
+  }
+}
+#endif
+
+uint32_t recordEncodeFrame(uint8_t * frame, const RecordSnapshot & previous, const RecordSnapshot & current, uint8_t ticks)
+{
+  uint8_t * groups = frame + 1;
+  uint8_t * cur = groups + RECORD_GROUPS_BYTES;
+
+  frame[0] = ticks;
+  memclear(groups, RECORD_GROUPS_BYTES);
+
+  for (uint32_t group=0; group<RECORD_GROUPS_COUNT; group++) {
+    uint8_t * mask = cur;
+    *mask = 0;
+    for (uint32_t i=group*8; i<(group+1)*8 && i<RECORD_SNAPSHOT_WORDS; i++) {
+      if (current.words[i] != previous.words[i]) {
+        if (*mask == 0)
+          cur++;
+        *mask |= 1 << (i % 8);
+        *cur++ = current.words[i];
+        *cur++ = current.words[i] >> 8;
+      }
+    }
+    if (*mask) {
+      groups[group/8] |= 1 << (group % 8);
+    }
+  }
+
+  return cur - frame;
+}
+
+const uint8_t * recordDecodeFrame(const uint8_t * frame, const uint8_t * end, RecordSnapshot & snapshot, uint8_t & ticks)
+{
+  if (end - frame < 1 + RECORD_GROUPS_BYTES)
+    return NULL;
+
+  ticks = frame[0];
+  const uint8_t * groups = frame + 1;
+  const uint8_t * cur = groups + RECORD_GROUPS_BYTES;
+
+  for (uint32_t group=0; group<RECORD_GROUPS_COUNT; group++) {
+    if (!(groups[group/8] & (1 << (group % 8))))
+      continue;
+    if (cur >= end)
+      return NULL;
+    uint8_t mask = *cur++;
+    for (uint32_t i=group*8; i<(group+1)*8; i++) {
+      if (mask & (1 << (i % 8))) {
+        if (i >= RECORD_SNAPSHOT_WORDS || end - cur < 2)
+          return NULL;
+        snapshot.words[i] = cur[0] | (cur[1] << 8);
+        cur += 2;
+      }
+    }
+  }
+
+  return cur;
+}
+
+#if defined(SDCARD)
+
+enum RecordState {
+  RECORD_STOPPED,
+  RECORD_RUNNING,
+  RECORD_STOPPING,
+};
+
+// the mixer task encodes the frames, the menus task writes them
+static Fifo<uint8_t, 4096> recordFifo;
+static FIL recordFile;
+static volatile uint8_t recordState = RECORD_STOPPED;
+static RecordSnapshot recordPrevious;
+static tmr10ms_t recordLastTime;
+
+bool isRecording()
+{
+  return recordState != RECORD_STOPPED;
+}
+
+const char * recordStart()
+{
+  char filename[40]; // /LOGS/INPUTS-2013-01-01-12-00-00.rec
+
+  if (isRecording())
+    return NULL;
+
+  if (!sdMounted())
+    return STR_NO_SDCARD;
+
+  if (sdGetFreeSectors() == 0)
+    return STR_SDCARD_FULL;
+
+  strcpy(filename, LOGS_PATH);
+  const char * error = sdCheckAndCreateDirectory(filename);
+  if (error) {
+    return error;
+  }
+
+  strcpy(filename, LOGS_PATH "/INPUTS");
+  char * tmp = &filename[sizeof(LOGS_PATH "/INPUTS")-1];
+#if defined(RTCLOCK)
+  tmp = strAppendDate(tmp, true);
+#endif
+  strcpy(tmp, RECORDS_EXT);
+
+  FRESULT result = f_open(&recordFile, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  RecordHeader header;
+  header.fourcc = RECORD_FOURCC;
+  header.version = RECORD_VERSION;
+  header.stickMode = g_eeGeneral.stickMode;
+  header.wordsCount = RECORD_SNAPSHOT_WORDS;
+  UINT written;
+  result = f_write(&recordFile, &header, sizeof(header), &written);
+  if (result != FR_OK || written != sizeof(header)) {
+    f_close(&recordFile);
+    return SDCARD_ERROR(result);
+  }
+
+  // the first frame holds all non zero words
+  memclear(&recordPrevious, sizeof(recordPrevious));
+  recordLastTime = get_tmr10ms();
+  recordFifo.clear();
+  recordState = RECORD_RUNNING;
+  TRACE("Inputs record started (%s)", filename);
+  return NULL;
+}
+
+void recordStop()
+{
+  if (recordState == RECORD_RUNNING) {
+    recordState = RECORD_STOPPING;
+  }
+}
+
+void recordMixerCycle()
+{
+  // kept out of the mixer stack
+  static uint8_t frame[RECORD_FRAME_MAX_SIZE];
+  static RecordSnapshot current;
+
+  if (recordState != RECORD_RUNNING)
+    return;
+
+  recordCapture(current);
+
+  tmr10ms_t now = get_tmr10ms();
+  tmr10ms_t ticks = now - recordLastTime;
+  recordLastTime = now;
+
+  uint32_t size = recordEncodeFrame(frame, recordPrevious, current, min<tmr10ms_t>(ticks, 255));
+  if (!recordFifo.hasSpace(size)) {
+    // a frame can't be dropped, the next ones would be wrong
+    TRACE("Inputs record overflow");
+    recordState = RECORD_STOPPING;
+    return;
+  }
+
+  for (uint32_t i=0; i<size; i++) {
+    recordFifo.push(frame[i]);
+  }
+  recordPrevious = current;
+}
+
+void recordWrite()
+{
+  uint8_t buffer[512];
+  uint32_t size = 0;
+  UINT written;
+  bool error = false;
+
+  if (recordState == RECORD_STOPPED)
+    return;
+
+  while (!error && recordFifo.pop(buffer[size])) {
+    if (++size == sizeof(buffer)) {
+      error = (f_write(&recordFile, buffer, size, &written) != FR_OK || written != size);
+      size = 0;
+    }
+  }
+
+  if (!error && size > 0) {
+    error = (f_write(&recordFile, buffer, size, &written) != FR_OK || written != size);
+  }
+
+  if (error) {
+    TRACE("Inputs record write error");
+    recordState = RECORD_STOPPING;
+  }
+
+  if (recordState == RECORD_STOPPING) {
+    f_close(&recordFile);
+    recordFifo.clear();
+    recordState = RECORD_STOPPED;
+    TRACE("Inputs record stopped");
+  }
+}
+
+#endif // #if defined(SDCARD)
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _RECORDER_H_
+#define _RECORDER_H_
+
+#if !defined(PCBTARANIS) && !defined(PCBHORUS)
+  #error "Inputs recorder is only available on Taranis and Horus"
+#endif
+
+// Mixer inputs record / replay
+//
+// Each mixer cycle the inputs read by doMixerCalculations() are captured in
+// a snapshot of 16 bits words, and only the words changed since the previous
+// cycle are written to the file.
+//
+// File: a RecordHeader, then for each mixer cycle:
+//   uint8_t  ticks       10ms ticks since the previous cycle
+//   uint8_t  groups[]    1 bit per group of 8 words, set when the group changed
+//   for each changed group:
+//     uint8_t  mask      1 bit per changed word
+//     uint16_t words[]   the changed words
+
+#define RECORD_FOURCC               0x5258544F // "OTXR"
+#define RECORD_VERSION              1
+#define RECORDS_EXT                 ".rec"
+
+#define RECORD_ANALOGS_COUNT        (NUM_STICKS+NUM_POTS+NUM_SLIDERS)
+#define RECORD_SWITCHES_WORDS       ((NUM_SWITCHES+7) / 8)  // 2 bits per switch
+
+#define RECORD_OFFSET_ANALOGS       0
+#define RECORD_OFFSET_SWITCHES      (RECORD_OFFSET_ANALOGS + RECORD_ANALOGS_COUNT)
+#define RECORD_OFFSET_TRIMS         (RECORD_OFFSET_SWITCHES + RECORD_SWITCHES_WORDS)
+#define RECORD_OFFSET_TRAINER       (RECORD_OFFSET_TRIMS + MAX_FLIGHT_MODES*NUM_TRIMS)
+#define RECORD_OFFSET_TELEMETRY     (RECORD_OFFSET_TRAINER + MAX_TRAINER_CHANNELS + 1)  // + validity timer
+#define RECORD_SNAPSHOT_WORDS       (RECORD_OFFSET_TELEMETRY + 3*MAX_TELEMETRY_SENSORS)  // value + age
+
+#define RECORD_GROUPS_COUNT         ((RECORD_SNAPSHOT_WORDS+7) / 8)
+#define RECORD_GROUPS_BYTES         ((RECORD_GROUPS_COUNT+7) / 8)
+#define RECORD_FRAME_MAX_SIZE       (1 + RECORD_GROUPS_BYTES + RECORD_GROUPS_COUNT + 2*RECORD_SNAPSHOT_WORDS)
+
+PACK(struct RecordHeader {
+  uint32_t fourcc;
+  uint8_t  version;
+  uint8_t  stickMode;
+  uint16_t wordsCount;
+});
+
+struct RecordSnapshot {
+  uint16_t words[RECORD_SNAPSHOT_WORDS];
+};
+
+void recordCapture(RecordSnapshot & snapshot);
+uint32_t recordEncodeFrame(uint8_t * frame, const RecordSnapshot & previous, const RecordSnapshot & current, uint8_t ticks);
+const uint8_t * recordDecodeFrame(const uint8_t * frame, const uint8_t * end, RecordSnapshot & snapshot, uint8_t & ticks);
+
+#if defined(SIMU)
+// restores everything but the analogs, which are owned by the simulator
+void recordApply(const RecordSnapshot & snapshot);
+#endif
+
+#if defined(SDCARD)
+const char * recordStart();
+void recordStop();
+void recordMixerCycle();
+void recordWrite();
+bool isRecording();
+#endif
+
+#endif // _RECORDER_H_
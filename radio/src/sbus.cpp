@@ -92,3 +92,16 @@ void processSbusInput()
   }
 #endif
 }
+
+// The frames are delimited by the gap which follows them, so the input must
+// be polled every 2ms as long as the trainer is in an SBUS mode
+bool isSbusInputActive()
+{
+#if defined(SIMU)
+  return false;
+#elif defined(PCBX7) || defined(PCBX9E)
+  return currentTrainerMode == TRAINER_MODE_MASTER_SBUS_EXTERNAL_MODULE;
+#else
+  return currentTrainerMode == TRAINER_MODE_MASTER_SBUS_EXTERNAL_MODULE || currentTrainerMode == TRAINER_MODE_MASTER_BATTERY_COMPARTMENT;
+#endif
+}
@@ -25,5 +25,6 @@
 #define SBUS_FRAME_SIZE       25
 
 void processSbusInput();
+bool isSbusInputActive();
 
 #endif // _SBUS_H_
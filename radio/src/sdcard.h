@@ -58,6 +58,7 @@ const char RADIO_SETTINGS_PATH[] = RADIO_PATH "/radio.bin";
 
 #define MODELS_EXT          ".bin"
 #define LOGS_EXT            ".csv"
+#define LOGS_FAST_EXT       ".bin"
 #define SOUNDS_EXT          ".wav"
 #define BMP_EXT             ".bmp"
 #define PNG_EXT             ".png"
@@ -100,6 +101,82 @@ void logsInit();
 void logsClose();
 void logsWrite();
 
+#if defined(CPUARM)
+#if defined(PCBHORUS)
+  #define LOGS_BUFFER_SIZE           (64*1024) // in SDRAM
+#elif defined(PCBSKY9X)
+  #define LOGS_BUFFER_SIZE           2048
+#else
+  #define LOGS_BUFFER_SIZE           4096
+#endif
+#if defined(PCBHORUS)
+  #define LOGS_FAST_BUFFER_SIZE      LOGS_BUFFER_SIZE // in SDRAM
+#else
+  #define LOGS_FAST_BUFFER_SIZE      1024  // records only, the header is written directly
+#endif
+#define LOGS_SECTOR_SIZE             512
+#define LOGS_PRINTF_BUFFER_SIZE      64
+#define LOGS_EXPAND_SIZE             (4*1024*1024)
+#define LOGS_TASK_PERIOD_TICKS       25    // 50ms
+
+static_assert((LOGS_BUFFER_SIZE & (LOGS_BUFFER_SIZE-1)) == 0, "LOGS_BUFFER_SIZE must be a power of 2");
+static_assert((LOGS_FAST_BUFFER_SIZE & (LOGS_FAST_BUFFER_SIZE-1)) == 0, "LOGS_FAST_BUFFER_SIZE must be a power of 2");
+
+// Fast logs
+//
+// A Logs special function with a negative parameter records a binary log,
+// sampled by the mixer task every -param*20ms (up to 50Hz): the analogs, the
+// channels used by the mixes and the numeric sensors which are logged. It
+// runs besides the CSV log.
+//
+// File (/LOGS/<model>-<date>-<time>.bin): a LogsFastHeader, then its columns
+// descriptions (LogsFastColumn), then fixed size records: the time, followed
+// by the value of each column. All fields are little endian.
+// radio/util/logs2csv.py converts it to CSV.
+
+#define LOGS_FAST_FOURCC             0x4C58544F // "OTXL"
+#define LOGS_FAST_VERSION            1
+#define LOGS_FAST_PERIOD_MAX         5          // 100ms
+#define LOGS_FAST_PERIOD_TICKS       10         // 20ms
+
+PACK(struct LogsFastHeader {
+  uint32_t fourcc;
+  uint8_t  version;
+  uint8_t  period;      // ms
+  uint16_t columns;
+  uint32_t startTime;   // RTC time of the first record (seconds since 1970), 0 if unknown
+});
+
+PACK(struct LogsFastColumn {
+  char     name[8];     // zero padded
+  char     unit[4];     // zero padded
+  uint8_t  precision;   // decimals
+  uint8_t  size;        // 2 or 4 bytes, signed
+});
+
+PACK(struct LogsFastRecord {
+  uint32_t time;        // ms since the first record
+  // followed by the columns values
+});
+
+struct LogsStats {
+  uint32_t records;
+  uint32_t overruns;      // records dropped, the buffer being full
+  uint32_t bufferMax;     // bytes
+  uint32_t bytes;         // written to the SD card
+  uint32_t flushes;
+  uint32_t flushTimeSum;  // ticks (2ms)
+  uint32_t flushTimeMax;
+};
+
+extern LogsStats logsStats;
+extern LogsStats logsFastStats;
+extern uint8_t logsFastPeriod;
+void logsStatsReset();
+void logsTask(void * pdata);
+void logsFastSample();
+#endif
+
 bool sdCardFormat();
 uint32_t sdGetNoSectors();
 uint32_t sdGetSize();
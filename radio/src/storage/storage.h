@@ -49,6 +49,7 @@ void storageEraseAll(bool warn);
 void storageFormat();
 void storageReadAll();
 void storageDirty(uint8_t msk);
+void storageDirtyValue(uint8_t msk);
 void storageCheck(bool immediately);
 void storageFlushCurrentModel();
 
@@ -28,7 +28,9 @@ uint8_t   rambackupDirtyMsk;
 tmr10ms_t rambackupDirtyTime10ms;
 #endif
 
-void storageDirty(uint8_t msk)
+// For the trims and GVARs values adjusted in flight: the model caches only
+// hold the model structure, they are kept
+void storageDirtyValue(uint8_t msk)
 {
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
@@ -39,6 +41,27 @@ void storageDirty(uint8_t msk)
 #endif
 }
 
+void storageDirty(uint8_t msk)
+{
+#if defined(CPUARM)
+  if (msk & EE_MODEL) {
+    invalidateMixerPlan();
+    invalidateLogicalSwitchesOrder();
+    invalidateTrimFlightModes();
+    invalidateTelemetrySensorsIndex();
+    invalidateCalculatedSensorsOrder();
+  }
+#endif
+
+#if defined(GVARS) && !defined(PCBSTD)
+  if (msk & EE_MODEL) {
+    invalidateGVarFlightModes();
+  }
+#endif
+
+  storageDirtyValue(msk);
+}
+
 void preModelLoad()
 {
 #if defined(CPUARM)
@@ -88,6 +111,18 @@ void postModelLoad(bool alarms)
 
   LOAD_MODEL_CURVES();
 
+#if defined(CPUARM)
+  invalidateMixerPlan();
+  buildLogicalSwitchesOrder();
+  invalidateTrimFlightModes();
+  invalidateTelemetrySensorsIndex();
+  invalidateCalculatedSensorsOrder();
+#endif
+
+#if defined(GVARS) && !defined(PCBSTD)
+  invalidateGVarFlightModes();
+#endif
+
   resumeMixerCalculations();
   if (pulsesStarted()) {
 #if defined(GUI)
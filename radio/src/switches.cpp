@@ -553,12 +553,108 @@ bool getSwitch(swsrc_t swtch)
 }
 
 #if defined(CPUARM)
+uint8_t lswOrder[MAX_LOGICAL_SWITCHES];
+bool lswOrderDirty = true;
+int8_t lswLoopIndex = -1;
+
+typedef uint64_t lsw_mask_t;
+#define LSW_MASK(idx) ((lsw_mask_t)1 << (idx))
+
+static lsw_mask_t lswSwitchMask(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  if (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH)
+    return LSW_MASK(swtch - SWSRC_FIRST_LOGICAL_SWITCH);
+  else
+    return 0;
+}
+
+static lsw_mask_t lswSourceMask(mixsrc_t source)
+{
+  if (source >= MIXSRC_FIRST_LOGICAL_SWITCH && source <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return LSW_MASK(source - MIXSRC_FIRST_LOGICAL_SWITCH);
+  else
+    return 0;
+}
+
+/**
+  @brief Returns the logical switches which have to be evaluated before the given one
+*/
+static lsw_mask_t lswDependencies(uint8_t idx)
+{
+  LogicalSwitchData * ls = lswAddress(idx);
+  if (ls->func == LS_FUNC_NONE)
+    return 0;
+
+  lsw_mask_t result = lswSwitchMask(ls->andsw);
+
+  switch (lswFamily(ls->func)) {
+    case LS_FAMILY_BOOL:
+      result |= lswSwitchMask(ls->v1) | lswSwitchMask(ls->v2);
+      break;
+    case LS_FAMILY_COMP:
+      result |= lswSourceMask(ls->v1) | lswSourceMask(ls->v2);
+      break;
+    case LS_FAMILY_OFS:
+    case LS_FAMILY_DIFF:
+      result |= lswSourceMask(ls->v1);
+      break;
+    default:
+      // timers, sticky and edge switches only read their inputs in logicalSwitchesTimerTick()
+      break;
+  }
+
+  // a switch which references itself reads its own previous state
+  return result & ~LSW_MASK(idx);
+}
+
+/**
+  @brief Sorts the logical switches so that each one is evaluated after the ones it depends on
+*/
+void buildLogicalSwitchesOrder()
+{
+  // cleared first, so that a modification done while we are building is not lost
+  lswOrderDirty = false;
+  lswLoopIndex = -1;
+
+  lsw_mask_t done = 0;
+  uint8_t count = 0;
+  bool progress = true;
+
+  while (progress) {
+    progress = false;
+    for (uint8_t idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+      if (!(done & LSW_MASK(idx)) && !(lswDependencies(idx) & ~done)) {
+        lswOrder[count++] = idx;
+        done |= LSW_MASK(idx);
+        progress = true;
+      }
+    }
+  }
+
+  // the switches left are part of a loop, they will read the state of the previous cycle
+  for (uint8_t idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+    if (!(done & LSW_MASK(idx))) {
+      if (lswLoopIndex < 0) {
+        TRACE("Logical switch L%d is part of a loop", idx+1);
+        lswLoopIndex = idx;
+      }
+      lswOrder[count++] = idx;
+    }
+  }
+}
+
 /**
   @brief Calculates new state of logical switches for mixerCurrentFlightMode
 */
 void evalLogicalSwitches(bool isCurrentPhase)
 {
-  for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+  if (lswOrderDirty) {
+    buildLogicalSwitchesOrder();
+  }
+
+  for (unsigned int i=0; i<MAX_LOGICAL_SWITCHES; i++) {
+    uint8_t idx = lswOrder[i];
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
     bool result = getLogicalSwitch(idx);
     if (isCurrentPhase) {
@@ -158,6 +158,7 @@ extern "C" void INTMODULE_TIMER_IRQHandler()
   INTMODULE_TIMER->SR &= ~TIM_SR_CC2IF;           // clear flag
   setupPulses(INTERNAL_MODULE);
   intmoduleSendNextFrame();
+  LATENCY_MEASURE(latencyDma);
   
   DEBUG_TIMER_STOP(debugTimerIntPulsesDuration);
 }
@@ -531,6 +531,8 @@ void telemetryPortInit(uint32_t baudrate, uint8_t mode);
 void telemetryPortSetDirectionOutput(void);
 void sportSendBuffer(uint8_t * buffer, uint32_t count);
 uint8_t telemetryGetByte(uint8_t * byte);
+uint32_t telemetryGetData(const uint8_t ** data);
+void telemetrySkipData(uint32_t count);
 extern uint32_t telemetryErrors;
 
 // Sport update driver
@@ -553,7 +555,8 @@ void hapticOn(uint32_t pwmPercent);
 
 // GPS driver
 void gpsInit(uint32_t baudrate);
-uint8_t gpsGetByte(uint8_t * byte);
+uint32_t gpsGetData(const uint8_t ** data);
+void gpsSkipData(uint32_t count);
 #if defined(DEBUG)
 extern uint8_t gpsTraceEnabled;
 #endif
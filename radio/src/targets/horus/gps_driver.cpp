@@ -98,13 +98,22 @@ extern "C" void GPS_USART_IRQHandler(void)
   }
 }
 
-uint8_t gpsGetByte(uint8_t * byte)
+// The received data is read in place, by contiguous chunks
+uint32_t gpsGetData(const uint8_t ** data)
+{
+  return gpsRxFifo.getContiguousData(*data);
+}
+
+void gpsSkipData(uint32_t count)
 {
-  uint8_t result = gpsRxFifo.pop(*byte);
 #if defined(DEBUG)
   if (gpsTraceEnabled) {
-    serialPutc(*byte);
+    const uint8_t * data;
+    gpsRxFifo.getContiguousData(data);
+    for (uint32_t i=0; i<count; i++) {
+      serialPutc(data[i]);
+    }
   }
 #endif
-  return result;
+  gpsRxFifo.skip(count);
 }
\ No newline at end of file
@@ -201,8 +201,14 @@ extern "C" void TELEMETRY_USART_IRQHandler(void)
     uint8_t data = TELEMETRY_USART->DR;
     if (status & USART_FLAG_ERRORS) {
       telemetryErrors++;
+      if (status & USART_FLAG_ORE) {
+        telemetryLinkStats.overruns++;
+      }
     }
     else {
+      if (telemetryNoDMAFifo.isFull()) {
+        telemetryLinkStats.overruns++;
+      }
       telemetryNoDMAFifo.push(data);
 #if defined(LUA)
       if (telemetryProtocol == PROTOCOL_FRSKY_SPORT) {
@@ -230,3 +236,27 @@ uint8_t telemetryGetByte(uint8_t * byte)
   return telemetryNoDMAFifo.pop(*byte);
 #endif
 }
+
+uint32_t telemetryGetData(const uint8_t ** data)
+{
+#if defined(PCBX12S)
+  if (telemetryFifoMode & TELEMETRY_SERIAL_WITHOUT_DMA)
+    return telemetryNoDMAFifo.getContiguousData(*data);
+  else
+    return telemetryDMAFifo.getContiguousData(*data);
+#else
+  return telemetryNoDMAFifo.getContiguousData(*data);
+#endif
+}
+
+void telemetrySkipData(uint32_t count)
+{
+#if defined(PCBX12S)
+  if (telemetryFifoMode & TELEMETRY_SERIAL_WITHOUT_DMA)
+    telemetryNoDMAFifo.skip(count);
+  else
+    telemetryDMAFifo.skip(count);
+#else
+  telemetryNoDMAFifo.skip(count);
+#endif
+}
@@ -397,6 +397,38 @@ void OpenTxSimulator::setLuaStateReloadPermanentScripts()
 #endif
 }
 
+void OpenTxSimulator::setInputsRecording(bool enable)
+{
+#if defined(INPUTS_RECORDER)
+  // written in the LOGS folder of the simulated SD card
+  if (enable) {
+    const char * error = recordStart();
+    if (error)
+      emit runtimeError(QString("Inputs record: %1").arg(error));
+  }
+  else {
+    recordStop();
+  }
+#endif
+}
+
+void OpenTxSimulator::setTelemetryReplay(const QString & path, int speed)
+{
+#if defined(STM32)
+  if (path.isEmpty()) {
+    telemetryReplayStop();
+  }
+  else {
+    const char * error = telemetryReplayStart(path.toLocal8Bit().constData(), speed);
+    if (error)
+      emit runtimeError(QString("Telemetry replay: %1").arg(error));
+  }
+#else
+  Q_UNUSED(path)
+  Q_UNUSED(speed)
+#endif
+}
+
 void OpenTxSimulator::addTracebackDevice(QIODevice * device)
 {
   QMutexLocker lckr(&m_mtxTbDevices);
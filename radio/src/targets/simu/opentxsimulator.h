@@ -67,6 +67,8 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual void setTrainerTimeout(uint16_t ms);
     virtual void sendTelemetry(const QByteArray data);
     virtual void setLuaStateReloadPermanentScripts();
+    virtual void setInputsRecording(bool enable);
+    virtual void setTelemetryReplay(const QString & path, int speed);
     virtual void addTracebackDevice(QIODevice * device);
     virtual void removeTracebackDevice(QIODevice * device);
 
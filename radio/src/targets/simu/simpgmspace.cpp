@@ -29,6 +29,8 @@
 #include <errno.h>
 #include <stdarg.h>
 #include <string>
+#include <mutex>
+#include <condition_variable>
 
 #if !defined (_MSC_VER) || defined (__GNUC__)
   #include <chrono>
@@ -49,6 +51,10 @@ pthread_t main_thread_pid;
 uint8_t main_thread_running = 0;
 char * main_thread_error = NULL;
 
+#if defined(CPUARM)
+pthread_t pulses_thread_pid;
+#endif
+
 #if defined(STM32)
 uint32_t Peri1_frequency, Peri2_frequency;
 GPIO_TypeDef gpioa, gpiob, gpioc, gpiod, gpioe, gpiof, gpiog, gpioh, gpioi, gpioj;
@@ -365,6 +371,67 @@ void simuSetSwitch(uint8_t swtch, int8_t state)
   }
 }
 
+#if defined(CPUARM)
+#define SIMU_LATENCY_REPORT_PERIOD     5000000 // 5s
+
+void simuLatencyReport()
+{
+  for (uint8_t module=0; module<NUM_MODULES; module++) {
+    MixerSchedulerStats & stats = mixerSchedulerStats[module];
+    if (stats.count) {
+      TRACE("Module %d latency (sticks to frame): min=%dus max=%dus avg=%dus jitter=%dus frames=%d",
+            module, stats.latencyMin/2, stats.latencyMax/2, int(stats.latencySum/stats.count/2),
+            (stats.latencyMax-stats.latencyMin)/2, int(stats.count));
+    }
+  }
+  resetMixerSchedulerStats();
+
+#if defined(DEBUG_LATENCY)
+  for (uint8_t point=0; point<LATENCY_POINTS_COUNT; point++) {
+    LatencyHistogram & histogram = latencyHistograms[point];
+    if (histogram.getCount()) {
+      TRACE("%s: min=%dus p50=%dus p99=%dus max=%dus n=%d", latencyPointNames[point], int(histogram.getMin()),
+            int(histogram.getPercentile(50)), int(histogram.getPercentile(99)), int(histogram.getMax()), int(histogram.getCount()));
+    }
+  }
+  resetLatencyHistograms();
+#endif
+}
+
+// Emulates the module timers interrupts, which start the frames and schedule the mixer
+void * simuPulsesThread(void *)
+{
+  uint64_t nextFrame[NUM_MODULES] = { 0 };
+  uint64_t nextReport = simuTimerMicros() + SIMU_LATENCY_REPORT_PERIOD;
+
+  while (main_thread_running) {
+    uint64_t now = simuTimerMicros();
+    if (!s_pulses_paused) {
+      for (uint8_t module=0; module<NUM_MODULES; module++) {
+#if !defined(PCBTARANIS) && !defined(PCBHORUS)
+        if (module != EXTERNAL_MODULE)
+          continue;
+#endif
+        if (now >= nextFrame[module]) {
+          setupPulses(module);
+          LATENCY_MEASURE(latencyDma);
+          // modules without mixer scheduling are polled every 20ms
+          uint16_t period = mixerSchedulerPeriod[module] ? mixerSchedulerPeriod[module] : 20;
+          nextFrame[module] = now + period * 1000;
+        }
+      }
+    }
+    if (now >= nextReport) {
+      simuLatencyReport();
+      nextReport = now + SIMU_LATENCY_REPORT_PERIOD;
+    }
+    sleep(1/*ms*/);
+  }
+
+  return NULL;
+}
+#endif
+
 void StartSimu(bool tests, const char * sdPath, const char * settingsPath)
 {
   if (main_thread_running)
@@ -403,6 +470,9 @@ void StartSimu(bool tests, const char * sdPath, const char * settingsPath)
 #endif
 
   pthread_create(&main_thread_pid, NULL, &simuMain, NULL);
+#if defined(CPUARM)
+  pthread_create(&pulses_thread_pid, NULL, &simuPulsesThread, NULL);
+#endif
 
 #if defined(SIMU_EXCEPTIONS)
   }
@@ -419,8 +489,12 @@ void StopSimu()
   main_thread_running = 0;
 
 #if defined(CPUARM)
+  pthread_join(pulses_thread_pid, NULL);
   pthread_join(mixerTaskId, NULL);
   pthread_join(menusTaskId, NULL);
+#if defined(SDCARD)
+  pthread_join(logsTaskId, NULL);
+#endif
 #endif
   pthread_join(main_thread_pid, NULL);
 }
@@ -739,3 +813,64 @@ OS_TID CoCreateTask(FUNCPtr task, void *argv, uint32_t parameter, void * stk, ui
   pthread_create(&tid, NULL, start_routine, (void *)task);
   return tid;
 }
+
+#define SIMU_MAX_FLAGS   4
+
+struct SimuFlag {
+  bool autoReset;
+  bool state;
+};
+
+SimuFlag simuFlags[SIMU_MAX_FLAGS];
+uint8_t simuFlagsCount = 0;
+std::mutex simuFlagsMutex;
+std::condition_variable simuFlagsCondition;
+
+OS_FlagID CoCreateFlag(bool autoReset, bool initialState)
+{
+  std::lock_guard<std::mutex> lock(simuFlagsMutex);
+  if (simuFlagsCount >= SIMU_MAX_FLAGS)
+    return SIMU_MAX_FLAGS;
+  simuFlags[simuFlagsCount].autoReset = autoReset;
+  simuFlags[simuFlagsCount].state = initialState;
+  return simuFlagsCount++;
+}
+
+void CoSetFlag(OS_FlagID id)
+{
+  if (id < SIMU_MAX_FLAGS) {
+    std::lock_guard<std::mutex> lock(simuFlagsMutex);
+    simuFlags[id].state = true;
+    simuFlagsCondition.notify_all();
+  }
+}
+
+void CoClearFlag(OS_FlagID id)
+{
+  if (id < SIMU_MAX_FLAGS) {
+    std::lock_guard<std::mutex> lock(simuFlagsMutex);
+    simuFlags[id].state = false;
+  }
+}
+
+// timeout in 2ms ticks, 0 = wait forever (as in CoOS)
+int CoWaitForSingleFlag(OS_FlagID id, uint32_t timeout)
+{
+  if (id >= SIMU_MAX_FLAGS) {
+    CoTickDelay(timeout);
+    return E_TIMEOUT;
+  }
+
+  std::unique_lock<std::mutex> lock(simuFlagsMutex);
+  SimuFlag & flag = simuFlags[id];
+  if (timeout == 0) {
+    simuFlagsCondition.wait(lock, [&flag] { return flag.state; });
+  }
+  else if (!simuFlagsCondition.wait_for(lock, std::chrono::milliseconds(2 * timeout), [&flag] { return flag.state; })) {
+    return E_TIMEOUT;
+  }
+  if (flag.autoReset) {
+    flag.state = false;
+  }
+  return E_OK;
+}
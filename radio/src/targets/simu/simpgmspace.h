@@ -393,6 +393,7 @@ extern OS_MutexID audioMutex;
 #define OS_STK uint32_t
 
 #define E_OK   0
+#define E_TIMEOUT  5
 #define WDRF   0
 
 void * simuMain(void * args = NULL);
@@ -412,15 +413,16 @@ OS_TID CoCreateTask(FUNCPtr task, void *argv, uint32_t parameter, void * stk, ui
 #define CoEnterMutexSection(m)         pthread_mutex_lock(&(m))
 #define CoLeaveMutexSection(m)         pthread_mutex_unlock(&(m))
 
-#define CoSetFlag(...)
-#define CoClearFlag(...)
+OS_FlagID CoCreateFlag(bool autoReset, bool initialState);
+void CoSetFlag(OS_FlagID id);
+void CoClearFlag(OS_FlagID id);
+int CoWaitForSingleFlag(OS_FlagID id, uint32_t timeout);
+#define isr_SetFlag(id)                CoSetFlag(id)
 #define CoSetTmrCnt(...)
 #define CoEnterISR(...)
 #define CoExitISR(...)
 #define CoStartTmr(...)
-#define CoWaitForSingleFlag(...)       0
 #define CoTickDelay(x)                 sleep(2*(x))
-#define CoCreateFlag(...)              0
 U64 CoGetOSTime(void);
 
 #define UART_Stop(...)
@@ -207,13 +207,6 @@ void sdInit(void)
   if (f_mount(&g_FATFS_Obj, "", 1) == FR_OK) {
     // call sdGetFreeSectors() now because f_getfree() takes a long time first time it's called
     sdGetFreeSectors();
-
-#if defined(LOG_TELEMETRY)
-    f_open(&g_telemetryFile, LOGS_PATH "/telemetry.log", FA_OPEN_ALWAYS | FA_WRITE);
-    if (f_size(&g_telemetryFile) > 0) {
-      f_lseek(&g_telemetryFile, f_size(&g_telemetryFile)); // append
-    }
-#endif
   }
   else {
     TRACE_SIMPGMSPACE("f_mount() failed");
@@ -225,7 +218,7 @@ void sdDone()
   if (sdMounted()) {
     audioQueue.stopSD();
 #if defined(LOG_TELEMETRY)
-    f_close(&g_telemetryFile);
+    telemetryCaptureClose();
 #endif
     f_mount(NULL, "", 0); // unmount SD
   }
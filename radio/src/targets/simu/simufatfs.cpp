@@ -391,6 +391,19 @@ UINT f_size(FIL* fil)
   return 0;
 }
 
+FRESULT f_expand (FIL* fil, FSIZE_t fsz, BYTE opt)
+{
+  return FR_OK;
+}
+
+FRESULT f_sync (FIL * fil)
+{
+  if (fil && fil->obj.fs) {
+    fflush((FILE*)fil->obj.fs);
+  }
+  return FR_OK;
+}
+
 FRESULT f_close (FIL * fil)
 {
   TRACE_SIMPGMSPACE("f_close(%p) (FIL:%p)", fil->obj.fs, fil);
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdio.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "opentx.h"
+
+#if defined(STM32)
+
+struct TelemetryReplayFrame {
+  uint64_t time;      // ns since the first frame
+  uint8_t  protocol;
+  uint32_t offset;    // in telemetryReplay.payloads
+  uint32_t length;
+};
+
+struct TelemetryReplay {
+  std::vector<TelemetryReplayFrame> frames;
+  std::vector<uint8_t> payloads;
+  uint32_t index;
+  uint32_t speed;
+  uint64_t startTime;
+  TelemetryReplayStats stats;
+  bool running;
+};
+
+// started / stopped by the UI thread, fed by the mixer thread
+static std::mutex telemetryReplayMutex;
+static TelemetryReplay telemetryReplay;
+
+static uint64_t telemetryReplayNanos()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const char * telemetryReplayLoadCapture(TelemetryReplay & replay, const std::vector<uint8_t> & data)
+{
+  TelemetryCaptureHeader header;
+  memcpy(&header, data.data(), sizeof(header));
+  if (header.version != TELEMETRY_CAPTURE_VERSION) {
+    return "capture version not supported";
+  }
+
+  const uint8_t * cur = data.data() + sizeof(header);
+  const uint8_t * end = data.data() + data.size();
+  uint64_t time = 0;
+  uint32_t lastTime = 0;
+
+  while (end - cur >= (ptrdiff_t)sizeof(TelemetryCaptureFrame)) {
+    TelemetryCaptureFrame frame;
+    memcpy(&frame, cur, sizeof(frame));
+    cur += sizeof(frame);
+    if (end - cur < frame.length) {
+      return "truncated capture";
+    }
+    if (!replay.frames.empty()) {
+      // the capture time wraps every 35 minutes
+      time += (uint64_t)(uint32_t)(frame.time - lastTime) * 500;
+    }
+    lastTime = frame.time;
+    replay.frames.push_back({time, frame.protocol, (uint32_t)replay.payloads.size(), frame.length});
+    replay.payloads.insert(replay.payloads.end(), cur, cur + frame.length);
+    cur += frame.length;
+  }
+
+  return NULL;
+}
+
+// "2017-02-01,12:30:45.120: 7E 98 10 00 01 ..." lines, 1 frame per line
+static const char * telemetryReplayLoadTextDump(TelemetryReplay & replay, const std::vector<uint8_t> & data)
+{
+  std::string text(data.begin(), data.end());
+  uint64_t firstTime = 0;
+  uint64_t lastTime = 0;
+  uint64_t dayOffset = 0;
+  size_t pos = 0;
+
+  while (pos < text.size()) {
+    size_t eol = text.find('\n', pos);
+    if (eol == std::string::npos)
+      eol = text.size();
+    std::string line = text.substr(pos, eol - pos);
+    pos = eol + 1;
+
+    size_t separator = line.find(": ");
+    if (separator == std::string::npos)
+      continue;
+
+    int year, month, day, hour, minute, second, ms;
+    uint64_t time = lastTime;
+    if (sscanf(line.c_str(), "%d-%d-%d,%d:%d:%d.%d", &year, &month, &day, &hour, &minute, &second, &ms) == 7) {
+      time = dayOffset + ((uint64_t)((hour*60 + minute)*60 + second) * 1000 + ms) * 1000000;
+      if (replay.frames.empty()) {
+        firstTime = time;
+      }
+      else if (time < lastTime) {
+        // midnight
+        dayOffset += (uint64_t)24*3600*1000000000;
+        time += (uint64_t)24*3600*1000000000;
+      }
+      lastTime = time;
+    }
+
+    uint32_t offset = replay.payloads.size();
+    const char * cur = line.c_str() + separator + 2;
+    char * next;
+    for (unsigned long byte = strtoul(cur, &next, 16); next != cur; byte = strtoul(cur, &next, 16)) {
+      replay.payloads.push_back(byte);
+      cur = next;
+    }
+
+    if (replay.payloads.size() > offset) {
+      replay.frames.push_back({time - firstTime, telemetryProtocol, offset, (uint32_t)(replay.payloads.size() - offset)});
+    }
+  }
+
+  return NULL;
+}
+
+const char * telemetryReplayStart(const char * path, uint32_t speed)
+{
+  FILE * file = fopen(path, "rb");
+  if (!file) {
+    return "can't open capture";
+  }
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t len;
+  while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + len);
+  }
+  fclose(file);
+
+  TelemetryReplay replay;
+  const char * error;
+  if (data.size() >= sizeof(TelemetryCaptureHeader) && *(uint32_t *)data.data() == TELEMETRY_CAPTURE_FOURCC)
+    error = telemetryReplayLoadCapture(replay, data);
+  else
+    error = telemetryReplayLoadTextDump(replay, data);
+  if (error) {
+    return error;
+  }
+  if (replay.frames.empty()) {
+    return "empty capture";
+  }
+
+  if (replay.frames[0].protocol != telemetryProtocol) {
+    TRACE("Telemetry replay: capture protocol %d decoded instead of the model protocol %d", replay.frames[0].protocol, telemetryProtocol);
+  }
+
+  std::lock_guard<std::mutex> lock(telemetryReplayMutex);
+  telemetryReplay.frames.swap(replay.frames);
+  telemetryReplay.payloads.swap(replay.payloads);
+  telemetryReplay.index = 0;
+  telemetryReplay.speed = speed;
+  telemetryReplay.startTime = telemetryReplayNanos();
+  memclear(&telemetryReplay.stats, sizeof(telemetryReplay.stats));
+  telemetryReplay.running = true;
+  TRACE("Telemetry replay started (%s, %d frames)", path, (int)telemetryReplay.frames.size());
+  return NULL;
+}
+
+void telemetryReplayStop()
+{
+  std::lock_guard<std::mutex> lock(telemetryReplayMutex);
+  telemetryReplay.running = false;
+}
+
+bool isTelemetryReplaying()
+{
+  std::lock_guard<std::mutex> lock(telemetryReplayMutex);
+  return telemetryReplay.running;
+}
+
+void telemetryReplayGetStats(TelemetryReplayStats & stats)
+{
+  std::lock_guard<std::mutex> lock(telemetryReplayMutex);
+  stats = telemetryReplay.stats;
+}
+
+void telemetryReplayWakeup()
+{
+  std::lock_guard<std::mutex> lock(telemetryReplayMutex);
+  TelemetryReplay & replay = telemetryReplay;
+
+  if (!replay.running)
+    return;
+
+  uint64_t now = telemetryReplayNanos() - replay.startTime;
+  for (uint32_t count=0; replay.index < replay.frames.size(); count++) {
+    const TelemetryReplayFrame & frame = replay.frames[replay.index];
+    if (replay.speed ? frame.time / replay.speed > now : count == TELEMETRY_REPLAY_BURST)
+      break;
+    // each frame is decoded with the protocol it was captured with, the
+    // model protocol is back for the next telemetryWakeup() check
+    uint8_t modelProtocol = telemetryProtocol;
+    telemetryProtocol = frame.protocol;
+    uint64_t start = telemetryReplayNanos();
+    processTelemetryData(&replay.payloads[frame.offset], frame.length);
+    replay.stats.decodeTime += telemetryReplayNanos() - start;
+    telemetryProtocol = modelProtocol;
+    replay.stats.frames++;
+    replay.stats.bytes += frame.length;
+    replay.index++;
+  }
+
+  replay.stats.elapsedTime = telemetryReplayNanos() - replay.startTime;
+
+  if (replay.index == replay.frames.size()) {
+    replay.running = false;
+    TRACE("Telemetry replay done: %d frames, %d frames/s, %dns decode per frame", replay.stats.frames,
+          (int)(replay.stats.frames * 1000000000ULL / max<uint64_t>(replay.stats.elapsedTime, 1)),
+          (int)(replay.stats.decodeTime / replay.stats.frames));
+  }
+}
+
+#endif // #if defined(STM32)
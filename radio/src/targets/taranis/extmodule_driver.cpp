@@ -342,4 +342,5 @@ extern "C" void EXTMODULE_TIMER_CC_IRQHandler()
   EXTMODULE_TIMER->SR &= ~TIM_SR_CC2IF;
   setupPulses(EXTERNAL_MODULE);
   extmoduleSendNextFrame();
+  LATENCY_MEASURE(latencyDma);
 }
@@ -171,4 +171,5 @@ extern "C" void INTMODULE_TIMER_CC_IRQHandler()
   INTMODULE_TIMER->SR &= ~TIM_SR_CC2IF;
   setupPulses(INTERNAL_MODULE);
   intmoduleSendNextFrame();
+  LATENCY_MEASURE(latencyDma);
 }
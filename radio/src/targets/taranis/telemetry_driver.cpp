@@ -153,8 +153,14 @@ extern "C" void TELEMETRY_USART_IRQHandler(void)
     uint8_t data = TELEMETRY_USART->DR;
     if (status & USART_FLAG_ERRORS) {
       telemetryErrors++;
+      if (status & USART_FLAG_ORE) {
+        telemetryLinkStats.overruns++;
+      }
     }
     else {
+      if (telemetryFifo.isFull()) {
+        telemetryLinkStats.overruns++;
+      }
       telemetryFifo.push(data);
 #if defined(LUA)
       if (telemetryProtocol == PROTOCOL_FRSKY_SPORT) {
@@ -187,3 +193,27 @@ uint8_t telemetryGetByte(uint8_t * byte)
   return telemetryFifo.pop(*byte);
 #endif
 }
+
+uint32_t telemetryGetData(const uint8_t ** data)
+{
+#if defined(SERIAL2)
+  if (telemetryProtocol == PROTOCOL_FRSKY_D_SECONDARY) {
+    if (serial2Mode == UART_MODE_TELEMETRY)
+      return serial2RxFifo.getContiguousData(*data);
+    else
+      return 0;
+  }
+#endif
+  return telemetryFifo.getContiguousData(*data);
+}
+
+void telemetrySkipData(uint32_t count)
+{
+#if defined(SERIAL2)
+  if (telemetryProtocol == PROTOCOL_FRSKY_D_SECONDARY) {
+    serial2RxFifo.skip(count);
+    return;
+  }
+#endif
+  telemetryFifo.skip(count);
+}
@@ -30,6 +30,12 @@ TaskStack<MIXER_STACK_SIZE> mixerStack;
 OS_TID audioTaskId;
 TaskStack<AUDIO_STACK_SIZE> audioStack;
 
+#if defined(SDCARD)
+OS_TID logsTaskId;
+TaskStack<LOGS_STACK_SIZE> logsStack;
+OS_MutexID logsMutex;
+#endif
+
 OS_MutexID audioMutex;
 OS_MutexID mixerMutex;
 
@@ -39,6 +45,7 @@ enum TaskIndex {
   AUDIO_TASK_INDEX,
   CLI_TASK_INDEX,
   BLUETOOTH_TASK_INDEX,
+  LOGS_TASK_INDEX,
   TASK_INDEX_COUNT,
   MAIN_TASK_INDEX = 255
 };
@@ -69,6 +76,9 @@ void stackPaint()
   menusStack.paint();
   mixerStack.paint();
   audioStack.paint();
+#if defined(SDCARD)
+  logsStack.paint();
+#endif
 #if defined(CLI)
   cliStack.paint();
 #endif
@@ -107,11 +117,23 @@ bool isForcePowerOffRequested()
   return false;
 }
 
+OS_FlagID mixerFlag;
 uint32_t nextMixerTime[NUM_MODULES];
+uint16_t mixerSchedulerPeriod[NUM_MODULES];
+uint16_t mixerDurationEstimate;
+uint16_t mixerSampleTime;
+MixerSchedulerStats mixerSchedulerStats[NUM_MODULES];
+
+void resetMixerSchedulerStats()
+{
+  memclear(mixerSchedulerStats, sizeof(mixerSchedulerStats));
+}
 
 void mixerTask(void * pdata)
 {
   static uint32_t lastRunTime;
+  uint32_t servedMixerTime[NUM_MODULES];
+  memclear(servedMixerTime, sizeof(servedMixerTime));
   s_pulses_paused = true;
 
   while(1) {
@@ -125,29 +147,48 @@ void mixerTask(void * pdata)
     processSbusInput();
 #endif
 
-    CoTickDelay(1);
+#if !defined(SIMU) && defined(STM32)
+    uint32_t maxPeriod = (usbStarted() ? MIXER_MAX_PERIOD_TICKS / 2 : MIXER_MAX_PERIOD_TICKS);   // run at least every 20ms (every 10ms if USB is active)
+#else
+    uint32_t maxPeriod = MIXER_MAX_PERIOD_TICKS;   // run at least every 20ms
+#endif
+
+    // sleep until the nearest deadline, a new frame will wake us up earlier
+    uint32_t now = CoGetOSTime();
+    int32_t timeout = lastRunTime + maxPeriod - now;
+    for (uint8_t module=0; module<NUM_MODULES; module++) {
+      uint32_t deadline = nextMixerTime[module];
+      if (deadline != servedMixerTime[module] && (int32_t)(deadline - now) < timeout) {
+        timeout = deadline - now;
+      }
+    }
+#if defined(SBUS)
+    // the SBUS trainer frames are only seen by processSbusInput() polled every tick
+    if (timeout > 1 && isSbusInputActive()) {
+      timeout = 1;
+    }
+#endif
+    if (timeout > 0) {
+      CoWaitForSingleFlag(mixerFlag, timeout);
+    }
 
+    // polled at least every maxPeriod, well enough for its 10s delay
     if (isForcePowerOffRequested()) {
       pwrOff();
     }
 
-    uint32_t now = CoGetOSTime();
+    now = CoGetOSTime();
     bool run = false;
-#if !defined(SIMU) && defined(STM32)
-    if ((now - lastRunTime) >= (usbStarted() ? 5 : 10)) {     // run at least every 20ms (every 10ms if USB is active)
-#else
-    if ((now - lastRunTime) >= 10) {     // run at least every 20ms
-#endif
-      run = true;
-    }
-    else if (now == nextMixerTime[0]) {
+    if ((now - lastRunTime) >= maxPeriod) {
       run = true;
     }
-#if NUM_MODULES >= 2
-    else if (now == nextMixerTime[1]) {
-      run = true;
+    for (uint8_t module=0; module<NUM_MODULES; module++) {
+      uint32_t deadline = nextMixerTime[module];
+      if (deadline != servedMixerTime[module] && (int32_t)(now - deadline) >= 0) {
+        servedMixerTime[module] = deadline;
+        run = true;
+      }
     }
-#endif
     if (!run) {
       continue;  // go back to sleep
     }
@@ -160,11 +201,23 @@ void mixerTask(void * pdata)
       DEBUG_TIMER_START(debugTimerMixer);
       CoEnterMutexSection(mixerMutex);
       doMixerCalculations();
+      mixerSampleTime = t0;
       DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
       DEBUG_TIMER_SAMPLE(debugTimerMixerIterval);
       CoLeaveMutexSection(mixerMutex);
       DEBUG_TIMER_STOP(debugTimerMixer);
 
+#if defined(SDCARD)
+      logsFastSample();
+#endif
+
+      // decaying maximum of the mixer duration, used to schedule the next run
+      uint16_t duration = getTmr2MHz() - t0;
+      if (duration > mixerDurationEstimate)
+        mixerDurationEstimate = duration;
+      else
+        mixerDurationEstimate -= (mixerDurationEstimate - duration) >> 4;
+
 #if defined(STM32) && !defined(SIMU)
       if (getSelectedUsbMode() == USB_JOYSTICK_MODE) {
         usbJoystickUpdate();
@@ -192,11 +245,32 @@ void mixerTask(void * pdata)
   }
 }
 
+// Called from the module interrupt when a frame starts
 void scheduleNextMixerCalculation(uint8_t module, uint16_t period_ms)
 {
-  // Schedule next mixer calculation time,
-  // for now assume mixer calculation takes 2 ms.
-  nextMixerTime[module] = (uint32_t)CoGetOSTime() + period_ms / 2 - 1/*2ms*/;
+  if (!s_pulses_paused) {
+    // the frame which starts now carries the sticks sampled by the last mixer run
+    uint16_t latency = getTmr2MHz() - mixerSampleTime;
+    MixerSchedulerStats & stats = mixerSchedulerStats[module];
+    if (stats.count == 0 || latency < stats.latencyMin)
+      stats.latencyMin = latency;
+    if (latency > stats.latencyMax)
+      stats.latencyMax = latency;
+    stats.latencySum += latency;
+    stats.count++;
+    LATENCY_MEASURE(latencyPulses);
+  }
+
+  // Schedule next mixer calculation time as late as possible, so that the
+  // mixer (which duration is measured) is done just before the next frame
+  int32_t delay = (int32_t)period_ms * 2000 - mixerDurationEstimate - MIXER_SCHEDULE_MARGIN;
+  nextMixerTime[module] = (uint32_t)CoGetOSTime() + (delay > 0 ? delay / 4000/*2ms*/ : 0);
+  mixerSchedulerPeriod[module] = period_ms;
+
+  CoEnterISR();
+  isr_SetFlag(mixerFlag);
+  CoExitISR();
+
   DEBUG_TIMER_STOP(debugTimerMixerCalcToUsage);
 }
 
@@ -270,6 +344,7 @@ void tasksStart()
   cliStart();
 #endif
 
+  mixerFlag = CoCreateFlag(true, false);
   mixerTaskId = CoCreateTask(mixerTask, NULL, 5, &mixerStack.stack[MIXER_STACK_SIZE-1], MIXER_STACK_SIZE);
   menusTaskId = CoCreateTask(menusTask, NULL, 10, &menusStack.stack[MENUS_STACK_SIZE-1], MENUS_STACK_SIZE);
 
@@ -278,6 +353,11 @@ void tasksStart()
   audioTaskId = CoCreateTask(audioTask, NULL, 7, &audioStack.stack[AUDIO_STACK_SIZE-1], AUDIO_STACK_SIZE);
 #endif
 
+#if defined(SDCARD)
+  logsTaskId = CoCreateTask(logsTask, NULL, 12, &logsStack.stack[LOGS_STACK_SIZE-1], LOGS_STACK_SIZE);
+  logsMutex = CoCreateMutex();
+#endif
+
   audioMutex = CoCreateMutex();
   mixerMutex = CoCreateMutex();
 
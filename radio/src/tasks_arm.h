@@ -27,10 +27,13 @@ extern "C" {
 }
 #endif
 
+#include "dataconstants.h"
+
 #define MENUS_STACK_SIZE       2000
 #define MIXER_STACK_SIZE       500
 #define AUDIO_STACK_SIZE       500
 #define BLUETOOTH_STACK_SIZE   500
+#define LOGS_STACK_SIZE        500
 
 #if defined(_MSC_VER)
 #define _ALIGNED(x) __declspec(align(x))
@@ -71,6 +74,33 @@ extern TaskStack<MIXER_STACK_SIZE> mixerStack;
 extern OS_TID audioTaskId;
 extern TaskStack<AUDIO_STACK_SIZE> audioStack;
 
+#if defined(SDCARD)
+// The logs task writes the buffered logs to the SD card
+extern OS_TID logsTaskId;
+extern TaskStack<LOGS_STACK_SIZE> logsStack;
+extern OS_MutexID logsMutex;
+#endif
+
+// The mixer task sleeps on this flag, it is set each time a module frame
+// starts and a new mixer deadline is scheduled
+extern OS_FlagID mixerFlag;
+
+#define MIXER_MAX_PERIOD_TICKS       10    // 20ms
+#define MIXER_SCHEDULE_MARGIN        1000  // 0.5ms (2MHz ticks)
+
+struct MixerSchedulerStats {
+  uint16_t latencyMin;   // stick sampling to frame start (2MHz ticks)
+  uint16_t latencyMax;
+  uint32_t latencySum;
+  uint32_t count;
+};
+
+extern uint32_t nextMixerTime[NUM_MODULES];
+extern uint16_t mixerSchedulerPeriod[NUM_MODULES];
+extern uint16_t mixerDurationEstimate;
+extern MixerSchedulerStats mixerSchedulerStats[NUM_MODULES];
+void resetMixerSchedulerStats();
+
 void tasksStart();
 
 extern volatile uint16_t timeForcePowerOffPressed;
@@ -96,9 +96,12 @@ void processCrossfireTelemetryFrame()
 {
   if (!checkCrossfireTelemetryFrameCRC()) {
     TRACE("[XF] CRC error");
+    telemetryLinkStats.crcErrors++;
     return;
   }
 
+  telemetryLinkFrameReceived();
+
   uint8_t id = telemetryRxBuffer[2];
   int32_t value;
   switch(id) {
@@ -188,6 +191,7 @@ void processCrossfireTelemetryData(uint8_t data)
 
   if (telemetryRxBufferCount == 1 && (data < 2 || data > TELEMETRY_RX_PACKET_SIZE-2)) {
     TRACE("[XF] length 0x%02X error", data);
+    telemetryLinkStats.resyncs++;
     telemetryRxBufferCount = 0;
     return;
   }
@@ -197,6 +201,7 @@ void processCrossfireTelemetryData(uint8_t data)
   }
   else {
     TRACE("[XF] array size %d error", telemetryRxBufferCount);
+    telemetryLinkStats.resyncs++;
     telemetryRxBufferCount = 0;
   }
 
@@ -209,6 +214,32 @@ void processCrossfireTelemetryData(uint8_t data)
   }
 }
 
+// Same as above, but the frames are copied at once once their length is known
+void processCrossfireTelemetryData(const uint8_t * data, uint32_t count)
+{
+  while (count > 0) {
+    if (telemetryRxBufferCount < 2 || telemetryRxBuffer[1] <= 2) {
+      // the address and the length are checked byte per byte, and the frames
+      // without payload go the same way, as they are not processed there
+      processCrossfireTelemetryData(*data++);
+      count--;
+      continue;
+    }
+
+    uint8_t length = telemetryRxBuffer[1];
+    uint32_t size = min<uint32_t>(length + 2 - telemetryRxBufferCount, count);
+    memcpy(&telemetryRxBuffer[telemetryRxBufferCount], data, size);
+    telemetryRxBufferCount += size;
+    data += size;
+    count -= size;
+
+    if (telemetryRxBufferCount == length + 2) {
+      processCrossfireTelemetryFrame();
+      telemetryRxBufferCount = 0;
+    }
+  }
+}
+
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId)
 {
   TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
@@ -74,6 +74,7 @@ enum CrossfireSensorIndexes {
 };
 
 void processCrossfireTelemetryData(uint8_t data);
+void processCrossfireTelemetryData(const uint8_t * data, uint32_t count);
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId);
 bool isCrossfireOutputBufferAvailable();
 
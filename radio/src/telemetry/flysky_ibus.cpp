@@ -41,6 +41,11 @@ struct FlySkySensor {
   const char *name;
   const TelemetryUnit unit;
   const uint8_t precision;
+
+  constexpr uint32_t key() const
+  {
+    return id;
+  }
 };
 
 #define TX_RSSI_ID              300      // Pseudo id outside 1 byte range of FlySky sensors
@@ -49,10 +54,9 @@ struct FlySkySensor {
 #define FS_ID_NOISE             0xfb
 #define FS_ID_RSSI              0xfc
 
-const FlySkySensor flySkySensors[] = {
+// sorted on id
+constexpr FlySkySensor flySkySensors[] = {
 
-  // RX Voltage (remapped, really 0x0)
-  {0x100,           ZSTR_A1,                UNIT_VOLTS,                  2},
   // Temperature
   {FS_ID_TEMP,      ZSTR_TEMP1,             UNIT_CELSIUS,                1},
   // RPM
@@ -68,12 +72,23 @@ const FlySkySensor flySkySensors[] = {
   // RX error rate
   {0xfe,            ZSTR_RX_QUALITY,        UNIT_RAW,                    0},
   // 0xff is an unused sensor slot
+  // RX Voltage (remapped, really 0x0)
+  {0x100,           ZSTR_A1,                UNIT_VOLTS,                  2},
   // Pseudo sensor for TRSSI
   {TX_RSSI_ID,      ZSTR_TX_RSSI,           UNIT_RAW,                    0},
-  // sentinel
-  {0x00,            NULL,                   UNIT_RAW,                    0},
 };
 
+static_assert(isSensorsTableSorted(flySkySensors), "FlySky sensors must be sorted on id");
+
+const FlySkySensor * getFlySkySensor(uint16_t id)
+{
+  const FlySkySensor * sensor = findSensorDescriptor(flySkySensors, id);
+  if (sensor < flySkySensors + DIM(flySkySensors) && sensor->id == id) {
+    return sensor;
+  }
+  return nullptr;
+}
+
 static void processFlySkySensor(const uint8_t *packet)
 {
   uint16_t id = packet[0];
@@ -94,24 +109,24 @@ static void processFlySkySensor(const uint8_t *packet)
     telemetryData.rssi.set(value);
   }
 
-  for (const FlySkySensor * sensor = flySkySensors; sensor->id; sensor++) {
-    // Extract value, skip header
-    if (sensor->id == id) {
-      // The Noise and Signal sensors that are specified in dB send the absolute value
-      if (id == FS_ID_NOISE || id == FS_ID_RSSI)
-        value = -value;
-      else if (id == FS_ID_TEMP)
-        // Temperature sensors have 40 degree offset
-        value -= 400;
-      setTelemetryValue(TELEM_PROTO_FLYSKY_IBUS, id, 0, instance, value, sensor->unit, sensor->precision);
-      return;
-    }
+  const FlySkySensor * sensor = getFlySkySensor(id);
+  if (sensor) {
+    // The Noise and Signal sensors that are specified in dB send the absolute value
+    if (id == FS_ID_NOISE || id == FS_ID_RSSI)
+      value = -value;
+    else if (id == FS_ID_TEMP)
+      // Temperature sensors have 40 degree offset
+      value -= 400;
+    setTelemetryValue(TELEM_PROTO_FLYSKY_IBUS, id, 0, instance, value, sensor->unit, sensor->precision);
+    return;
   }
   setTelemetryValue(TELEM_PROTO_FLYSKY_IBUS, id, 0, instance, value, UNIT_RAW, 0);
 }
 
 void processFlySkyPacket(const uint8_t *packet)
 {
+  telemetryLinkFrameReceived();
+
   // Set TX RSSI Value, reverse MULTIs scaling
   setTelemetryValue(TELEM_PROTO_FLYSKY_IBUS, TX_RSSI_ID, 0, 0, packet[0], UNIT_RAW, 0);
 
@@ -134,6 +149,7 @@ void processFlySkyTelemetryData(uint8_t data)
   }
   else {
     TRACE("[IBUS] array size %d error", telemetryRxBufferCount);
+    telemetryLinkStats.resyncs++;
     telemetryRxBufferCount = 0;
   }
 
@@ -154,15 +170,6 @@ void processFlySkyTelemetryData(uint8_t data)
   }
 }
 
-const FlySkySensor *getFlySkySensor(uint16_t id)
-{
-  for (const FlySkySensor * sensor = flySkySensors; sensor->id; sensor++) {
-    if (id == sensor->id)
-      return sensor;
-  }
-  return nullptr;
-}
-
 void flySkySetDefault(int index, uint16_t id, uint8_t subId, uint8_t instance)
 {
   TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
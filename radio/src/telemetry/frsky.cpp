@@ -79,6 +79,12 @@ NOINLINE void processFrskyTelemetryData(uint8_t data)
       }
       else if (data == START_STOP) {
         if (IS_FRSKY_SPORT_PROTOCOL()) {
+#if defined(CPUARM)
+          // a single byte is a poll left unanswered, more is a truncated frame
+          if (telemetryRxBufferCount > 1) {
+            telemetryLinkStats.resyncs++;
+          }
+#endif
           dataState = STATE_DATA_IN_FRAME ;
           telemetryRxBufferCount = 0;
         }
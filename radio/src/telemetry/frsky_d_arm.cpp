@@ -75,14 +75,23 @@ void frskyDProcessPacket(const uint8_t *packet)
       setTelemetryValue(TELEM_PROTO_FRSKY_D, D_RSSI_ID, 0, 0, packet[3], UNIT_RAW, 0);
       telemetryData.rssi.set(packet[3]);
       telemetryStreaming = TELEMETRY_TIMEOUT10ms; // reset counter only if valid packets are being detected
+      telemetryLinkFrameReceived();
       break;
     }
 
     case USRPKT: // User Data packet
+    {
       uint8_t numBytes = 3 + (packet[1] & 0x07); // sanitize in case of data corruption leading to buffer overflow
       for (uint8_t i=3; i<numBytes; i++) {
         parseTelemHubByte(packet[i]);
       }
+      telemetryLinkFrameReceived();
+      break;
+    }
+
+    default:
+      // the D protocol has no checksum, an unknown packet type is all we can detect
+      telemetryLinkStats.resyncs++;
       break;
   }
 }
@@ -92,43 +101,47 @@ struct FrSkyDSensor {
   const char * name;
   const TelemetryUnit unit;
   const uint8_t prec;
+
+  constexpr uint32_t key() const
+  {
+    return id;
+  }
 };
 
-const FrSkyDSensor frskyDSensors[] = {
-  { D_RSSI_ID, ZSTR_RSSI, UNIT_RAW, 0 },
-  { D_A1_ID, ZSTR_A1, UNIT_VOLTS, 1 },
-  { D_A2_ID, ZSTR_A2, UNIT_VOLTS, 1 },
+// sorted on id
+constexpr FrSkyDSensor frskyDSensors[] = {
+  { GPS_ALT_BP_ID, ZSTR_GPSALT, UNIT_METERS, 0 },
+  { TEMP1_ID, ZSTR_TEMP1, UNIT_CELSIUS, 0 },
   { RPM_ID, ZSTR_RPM, UNIT_RPMS, 0 },
   { FUEL_ID, ZSTR_FUEL, UNIT_PERCENT, 0 },
-  { TEMP1_ID, ZSTR_TEMP1, UNIT_CELSIUS, 0 },
   { TEMP2_ID, ZSTR_TEMP2, UNIT_CELSIUS, 0 },
-  { CURRENT_ID, ZSTR_CURR, UNIT_AMPS, 1 },
+  { VOLTS_ID, ZSTR_CELLS, UNIT_CELLS, 2 },
+  { GPS_SPEED_BP_ID, ZSTR_GSPD, UNIT_KTS, 0 },
+  { GPS_COURS_BP_ID, ZSTR_HDG, UNIT_DEGREE, 0 },
+  { GPS_HOUR_MIN_ID, ZSTR_GPSDATETIME, UNIT_DATETIME, 0 },
+  { GPS_LAT_AP_ID, ZSTR_GPS, UNIT_GPS, 0 },
+  { BARO_ALT_AP_ID, ZSTR_ALT, UNIT_METERS, 1 },   // we map hi precision vario into PREC1!
   { ACCEL_X_ID, ZSTR_ACCX, UNIT_G, 3 },
   { ACCEL_Y_ID, ZSTR_ACCY, UNIT_G, 3 },
   { ACCEL_Z_ID, ZSTR_ACCZ, UNIT_G, 3 },
+  { CURRENT_ID, ZSTR_CURR, UNIT_AMPS, 1 },
   { VARIO_ID, ZSTR_VSPD, UNIT_METERS_PER_SECOND, 2 },
   { VFAS_ID, ZSTR_VFAS, UNIT_VOLTS, 2 },
-  { BARO_ALT_AP_ID, ZSTR_ALT, UNIT_METERS, 1 },   // we map hi precision vario into PREC1!
   { VOLTS_AP_ID, ZSTR_VFAS, UNIT_VOLTS, 2 },
-  { GPS_SPEED_BP_ID, ZSTR_GSPD, UNIT_KTS, 0 },
-  { GPS_COURS_BP_ID, ZSTR_HDG, UNIT_DEGREE, 0 },
-  { VOLTS_ID, ZSTR_CELLS, UNIT_CELLS, 2 },
-  { GPS_ALT_BP_ID, ZSTR_GPSALT, UNIT_METERS, 0 },
-  { GPS_HOUR_MIN_ID, ZSTR_GPSDATETIME, UNIT_DATETIME, 0 },
-  { GPS_LAT_AP_ID, ZSTR_GPS, UNIT_GPS, 0 },
-  { 0, NULL, UNIT_RAW, 0 } // sentinel
+  { D_RSSI_ID, ZSTR_RSSI, UNIT_RAW, 0 },
+  { D_A1_ID, ZSTR_A1, UNIT_VOLTS, 1 },
+  { D_A2_ID, ZSTR_A2, UNIT_VOLTS, 1 },
 };
 
+static_assert(isSensorsTableSorted(frskyDSensors), "FrSky D sensors must be sorted on id");
+
 const FrSkyDSensor * getFrSkyDSensor(uint8_t id)
 {
-  const FrSkyDSensor * result = NULL;
-  for (const FrSkyDSensor * sensor = frskyDSensors; sensor->id; sensor++) {
-    if (id == sensor->id) {
-      result = sensor;
-      break;
-    }
+  const FrSkyDSensor * sensor = findSensorDescriptor(frskyDSensors, id);
+  if (sensor < frskyDSensors + DIM(frskyDSensors) && sensor->id == id) {
+    return sensor;
   }
-  return result;
+  return NULL;
 }
 
 uint8_t lastId = 0;
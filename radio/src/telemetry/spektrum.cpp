@@ -72,9 +72,15 @@ struct SpektrumSensor {
   const char *name;
   const TelemetryUnit unit;
   const uint8_t precision;
+
+  constexpr uint32_t key() const
+  {
+    return (i2caddress << 8) + startByte;
+  }
 };
 
-const SpektrumSensor spektrumSensors[] = {
+// sorted on (i2caddress, startByte)
+constexpr SpektrumSensor spektrumSensors[] = {
   // High voltage internal sensor
   {0x01,             0,  int16,     ZSTR_A1,                UNIT_VOLTS,                  1},
 
@@ -205,9 +211,10 @@ const SpektrumSensor spektrumSensors[] = {
 
   {I2C_PSEUDO_TX,    0,  uint8,     ZSTR_TX_RSSI,           UNIT_RAW,                    0},
   {I2C_PSEUDO_TX,    4,  uint32,    ZSTR_BIND,              UNIT_RAW,                    0},
-  {0,                0,  int16,     NULL,                   UNIT_RAW,                    0} //sentinel
 };
 
+static_assert(isSensorsTableSorted(spektrumSensors), "Spektrum sensors must be sorted on (i2caddress, startByte)");
+
 // The bcd int parameter has wrong endian
 static int32_t bcdToInt16(uint16_t bcd)
 {
@@ -271,6 +278,8 @@ bool isSpektrumValidValue(int32_t value, const SpektrumDataType type)
 
 void processSpektrumPacket(const uint8_t *packet)
 {
+  telemetryLinkFrameReceived();
+
   setTelemetryValue(TELEM_PROTO_SPEKTRUM, (I2C_PSEUDO_TX << 8) + 0, 0, 0, packet[1], UNIT_RAW, 0);
   // highest bit indicates that TM1100 is in use, ignore it
   uint8_t i2cAddress = (packet[2] & 0x7f);
@@ -293,50 +302,49 @@ void processSpektrumPacket(const uint8_t *packet)
   }
 
   bool handled = false;
-  for (const SpektrumSensor * sensor = spektrumSensors; sensor->i2caddress; sensor++) {
-    if (i2cAddress == sensor->i2caddress) {
-      handled = true;
+  const SpektrumSensor * end = spektrumSensors + DIM(spektrumSensors);
+  for (const SpektrumSensor * sensor = findSensorDescriptor(spektrumSensors, i2cAddress << 8); sensor < end && sensor->i2caddress == i2cAddress; sensor++) {
+    handled = true;
 
-      // Extract value, skip header
-      int32_t value = spektrumGetValue(packet + 4, sensor->startByte, sensor->dataType);
+    // Extract value, skip header
+    int32_t value = spektrumGetValue(packet + 4, sensor->startByte, sensor->dataType);
 
-      if (!isSpektrumValidValue(value, sensor->dataType))
-        continue;
+    if (!isSpektrumValidValue(value, sensor->dataType))
+      continue;
 
-      if (i2cAddress == I2C_CELLS && sensor->unit == UNIT_VOLTS) {
-        // Map to FrSky style cell values
-        int cellIndex = (sensor->startByte / 2) << 16;
-        value = value | cellIndex;
-      }
+    if (i2cAddress == I2C_CELLS && sensor->unit == UNIT_VOLTS) {
+      // Map to FrSky style cell values
+      int cellIndex = (sensor->startByte / 2) << 16;
+      value = value | cellIndex;
+    }
 
-      if (sensor->i2caddress == I2C_HIGH_CURRENT && sensor->unit == UNIT_AMPS)
-        // Spektrum's documents talks says: Resolution: 300A/2048 = 0.196791 A/tick
-        // Note that 300/2048 = 0,1464. DeviationTX also uses the 0.196791 figure
-        value = value * 196791 / 100000;
-      else if (sensor->i2caddress == I2C_GPS2 && sensor->unit == UNIT_DATETIME) {
-        // Frsky time is HH:MM:SS:00 bcd encodes while spektrum uses 0HH:MM:SS.S
-        value = (value & 0xfffffff0) << 4;
-      }
+    if (sensor->i2caddress == I2C_HIGH_CURRENT && sensor->unit == UNIT_AMPS)
+      // Spektrum's documents talks says: Resolution: 300A/2048 = 0.196791 A/tick
+      // Note that 300/2048 = 0,1464. DeviationTX also uses the 0.196791 figure
+      value = value * 196791 / 100000;
+    else if (sensor->i2caddress == I2C_GPS2 && sensor->unit == UNIT_DATETIME) {
+      // Frsky time is HH:MM:SS:00 bcd encodes while spektrum uses 0HH:MM:SS.S
+      value = (value & 0xfffffff0) << 4;
+    }
 
-      // Check if this looks like a LemonRX Transceiver, they use QoS Frame loss A as RSSI indicator(0-100)
-      if (i2cAddress == I2C_QOS && sensor->startByte == 0) {
-        if (spektrumGetValue(packet + 4, 2, uint16) == 0x8000 &&
-            spektrumGetValue(packet + 4, 4, uint16) == 0x8000 &&
-            spektrumGetValue(packet + 4, 6, uint16) == 0x8000 &&
-            spektrumGetValue(packet + 4, 8, uint16) == 0x8000) {
-          telemetryData.rssi.set(value);
-        }
-        else {
-          // Otherwise use the received signal strength of the telemetry packet as indicator
-          // Range is 0-31, multiply by 3 to get an almost full reading for 0x1f, the maximum the cyrf chip reports
-          telemetryData.rssi.set(packet[1] * 3);
-        }
-        telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+    // Check if this looks like a LemonRX Transceiver, they use QoS Frame loss A as RSSI indicator(0-100)
+    if (i2cAddress == I2C_QOS && sensor->startByte == 0) {
+      if (spektrumGetValue(packet + 4, 2, uint16) == 0x8000 &&
+          spektrumGetValue(packet + 4, 4, uint16) == 0x8000 &&
+          spektrumGetValue(packet + 4, 6, uint16) == 0x8000 &&
+          spektrumGetValue(packet + 4, 8, uint16) == 0x8000) {
+        telemetryData.rssi.set(value);
       }
-      
-      uint16_t pseudoId = (sensor->i2caddress << 8 | sensor->startByte);
-      setTelemetryValue(TELEM_PROTO_SPEKTRUM, pseudoId, 0, instance, value, sensor->unit, sensor->precision);
+      else {
+        // Otherwise use the received signal strength of the telemetry packet as indicator
+        // Range is 0-31, multiply by 3 to get an almost full reading for 0x1f, the maximum the cyrf chip reports
+        telemetryData.rssi.set(packet[1] * 3);
+      }
+      telemetryStreaming = TELEMETRY_TIMEOUT10ms;
     }
+    
+    uint16_t pseudoId = (sensor->i2caddress << 8 | sensor->startByte);
+    setTelemetryValue(TELEM_PROTO_SPEKTRUM, pseudoId, 0, instance, value, sensor->unit, sensor->precision);
   }
   if (!handled) {
     // If we see a sensor that is not handled at all, add the raw values of this sensor to show its existance to
@@ -418,6 +426,7 @@ void processSpektrumTelemetryData(uint8_t data)
   }
   else {
     TRACE("[SPK] array size %d error", telemetryRxBufferCount);
+    telemetryLinkStats.resyncs++;
     telemetryRxBufferCount = 0;
   }
 
@@ -447,10 +456,9 @@ const SpektrumSensor *getSpektrumSensor(uint16_t pseudoId)
 {
   uint8_t startByte = (uint8_t) (pseudoId & 0xff);
   uint8_t i2cadd = (uint8_t) (pseudoId >> 8);
-  for (const SpektrumSensor * sensor = spektrumSensors; sensor->i2caddress; sensor++) {
-    if (i2cadd == sensor->i2caddress && startByte == sensor->startByte) {
-      return sensor;
-    }
+  const SpektrumSensor * sensor = findSensorDescriptor(spektrumSensors, (i2cadd << 8) + startByte);
+  if (sensor < spektrumSensors + DIM(spektrumSensors) && i2cadd == sensor->i2caddress && startByte == sensor->startByte) {
+    return sensor;
   }
   return nullptr;
 }
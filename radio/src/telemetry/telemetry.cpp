@@ -32,6 +32,7 @@ uint8_t link_counter = 0;
 
 #if defined(CPUARM)
 uint8_t telemetryState = TELEMETRY_INIT;
+TelemetryLinkStats telemetryLinkStats;
 #endif
 
 TelemetryData telemetryData;
@@ -81,6 +82,80 @@ void processTelemetryData(uint8_t data)
   processFrskyTelemetryData(data);
 }
 
+#if defined(CPUARM)
+void telemetryLinkStatsReset()
+{
+  memclear(&telemetryLinkStats, sizeof(telemetryLinkStats));
+  telemetryLinkStats.protocol = telemetryProtocol;
+#if defined(STM32)
+  telemetryLinkStats.module = IS_TELEMETRY_INTERNAL_MODULE() ? INTERNAL_MODULE : EXTERNAL_MODULE;
+#else
+  telemetryLinkStats.module = EXTERNAL_MODULE;
+#endif
+}
+
+// Called by the protocols for each valid frame
+void telemetryLinkFrameReceived()
+{
+  uint16_t tmr2MHz = getTmr2MHz();
+  tmr10ms_t tmr10ms = get_tmr10ms();
+
+  if (telemetryLinkStats.frames++ > 0) {
+    // the 2MHz timer wraps every 32ms
+    uint32_t gap = (tmr10ms_t)(tmr10ms - telemetryLinkStats.lastFrameTmr10ms);
+    if (gap < 3)
+      gap = (uint16_t)(tmr2MHz - telemetryLinkStats.lastFrameTmr2MHz) / 2000;
+    else
+      gap *= 10;
+    uint8_t bucket = 0;
+    while (gap >= 2 && bucket < TELEMETRY_GAPS_COUNT - 1) {
+      gap >>= 1;
+      bucket++;
+    }
+    telemetryLinkStats.gaps[bucket]++;
+  }
+
+  telemetryLinkStats.lastFrameTmr10ms = tmr10ms;
+  telemetryLinkStats.lastFrameTmr2MHz = tmr2MHz;
+}
+#endif
+
+#if defined(STM32)
+// The protocol is dispatched once for the whole chunk
+void processTelemetryData(const uint8_t * data, uint32_t count)
+{
+#if defined(CROSSFIRE)
+  if (telemetryProtocol == PROTOCOL_PULSES_CROSSFIRE) {
+    processCrossfireTelemetryData(data, count);
+    return;
+  }
+#endif
+#if defined(MULTIMODULE)
+  if (telemetryProtocol == PROTOCOL_SPEKTRUM) {
+    for (uint32_t i=0; i<count; i++) {
+      processSpektrumTelemetryData(data[i]);
+    }
+    return;
+  }
+  if (telemetryProtocol == PROTOCOL_FLYSKY_IBUS) {
+    for (uint32_t i=0; i<count; i++) {
+      processFlySkyTelemetryData(data[i]);
+    }
+    return;
+  }
+  if (telemetryProtocol == PROTOCOL_MULTIMODULE) {
+    for (uint32_t i=0; i<count; i++) {
+      processMultiTelemetryData(data[i]);
+    }
+    return;
+  }
+#endif
+  for (uint32_t i=0; i<count; i++) {
+    processFrskyTelemetryData(data[i]);
+  }
+}
+#endif
+
 void telemetryWakeup()
 {
 #if defined(CPUARM)
@@ -97,14 +172,23 @@ void telemetryWakeup()
 #endif
 
 #if defined(STM32)
-  uint8_t data;
-  if (telemetryGetByte(&data)) {
-    LOG_TELEMETRY_WRITE_START();
-    do {
-      processTelemetryData(data);
-      LOG_TELEMETRY_WRITE_BYTE(data);
-    } while (telemetryGetByte(&data));
+  const uint8_t * data;
+  uint32_t count = telemetryGetData(&data);
+  while (count > 0) {
+    uint16_t start = getTmr2MHz();
+    processTelemetryData(data, count);
+    uint16_t duration = getTmr2MHz() - start;
+    telemetryLinkStats.decodeTime += duration;
+    if (duration > telemetryLinkStats.decodeTimeMax)
+      telemetryLinkStats.decodeTimeMax = duration;
+    LOG_TELEMETRY_WRITE_DATA(data, count);
+    telemetrySkipData(count);
+    // a second chunk when the data wraps at the end of the fifo
+    count = telemetryGetData(&data);
   }
+#if defined(SIMU)
+  telemetryReplayWakeup();
+#endif
 #elif defined(PCBSKY9X)
   if (telemetryProtocol == PROTOCOL_FRSKY_D_SECONDARY) {
     uint8_t data;
@@ -132,12 +216,7 @@ void telemetryWakeup()
 #endif
 
 #if defined(CPUARM)
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
 #endif
 
 #if defined(VARIO)
@@ -163,6 +242,7 @@ void telemetryWakeup()
           TelemetrySensor * sensor = & g_model.telemetrySensors[i];
           if (sensor->unit != UNIT_DATETIME) {
             item.setOld();
+            markTelemetryItemChanged(i);
             sensor_lost = true;
           }
         }
@@ -377,6 +457,7 @@ void telemetryReset()
 void telemetryInit(uint8_t protocol)
 {
   telemetryProtocol = protocol;
+  telemetryLinkStatsReset();
 
   if (protocol == PROTOCOL_FRSKY_D) {
     telemetryPortInit(FRSKY_D_BAUDRATE, TELEMETRY_SERIAL_DEFAULT);
@@ -446,26 +527,6 @@ NOINLINE uint8_t getRssiAlarmValue(uint8_t alarm)
 }
 #endif
 
-#if defined(LOG_TELEMETRY) && !defined(SIMU)
-extern FIL g_telemetryFile;
-void logTelemetryWriteStart()
-{
-  static tmr10ms_t lastTime = 0;
-  tmr10ms_t newTime = get_tmr10ms();
-  if (lastTime != newTime) {
-    struct gtm utm;
-    gettime(&utm);
-    f_printf(&g_telemetryFile, "\r\n%4d-%02d-%02d,%02d:%02d:%02d.%02d0:", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
-    lastTime = newTime;
-  }
-}
-
-void logTelemetryWriteByte(uint8_t data)
-{
-  f_printf(&g_telemetryFile, " %02X", data);
-}
-#endif
-
 uint8_t outputTelemetryBuffer[TELEMETRY_OUTPUT_FIFO_SIZE] __DMA;
 uint8_t outputTelemetryBufferSize = 0;
 uint8_t outputTelemetryBufferTrigger = 0;
@@ -62,6 +62,27 @@ enum TelemetryStates {
   TELEMETRY_KO
 };
 extern uint8_t telemetryState;
+
+// Receive link statistics, reset when the telemetry protocol changes
+#define TELEMETRY_GAPS_COUNT           10 // gaps[i] counts the gaps < 2^(i+1) ms, the last one all the longer ones
+
+struct TelemetryLinkStats {
+  uint8_t  protocol;
+  uint8_t  module;
+  uint32_t frames;
+  uint32_t crcErrors;
+  uint32_t resyncs;
+  uint32_t overruns;        // bytes lost, receive fifo full
+  uint32_t decodeTime;      // 0.5us unit
+  uint16_t decodeTimeMax;   // 0.5us unit, longest processTelemetryData() call
+  uint32_t gaps[TELEMETRY_GAPS_COUNT];
+  tmr10ms_t lastFrameTmr10ms;
+  uint16_t lastFrameTmr2MHz;
+};
+
+extern TelemetryLinkStats telemetryLinkStats;
+void telemetryLinkStatsReset();
+void telemetryLinkFrameReceived();
 #endif
 
 #define TELEMETRY_TIMEOUT10ms          100 // 1 second
@@ -109,6 +130,29 @@ PACK(struct CellValue
   }
 });
 
+// Hash index of the custom sensors on (id, subId, instance) used by setTelemetryValue().
+// Rebuilt on first access after the model has been changed
+extern bool telemetrySensorsIndexDirty;
+void buildTelemetrySensorsIndex();
+inline void invalidateTelemetrySensorsIndex()
+{
+  telemetrySensorsIndexDirty = true;
+}
+
+// Calculated sensors sorted so that each one is evaluated after its sources.
+// Rebuilt on first access after the model has been changed
+extern bool calculatedSensorsOrderDirty;
+void buildCalculatedSensorsOrder();
+inline void invalidateCalculatedSensorsOrder()
+{
+  calculatedSensorsOrderDirty = true;
+}
+void evalCalculatedSensors();
+
+#if defined(STM32)
+void processTelemetryData(const uint8_t * data, uint32_t count);
+#endif
+
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId, uint8_t instance, int32_t value, uint32_t unit, uint32_t prec);
 void delTelemetryIndex(uint8_t index);
 int availableTelemetryIndex();
@@ -165,16 +209,13 @@ inline uint8_t modelTelemetryProtocol()
 
 #if defined(CPUARM)
   #include "telemetry_sensors.h"
+  #include "telemetry_capture.h"
 #endif
 
-#if defined(LOG_TELEMETRY) && !defined(SIMU)
-void logTelemetryWriteStart();
-void logTelemetryWriteByte(uint8_t data);
-#define LOG_TELEMETRY_WRITE_START()    logTelemetryWriteStart()
-#define LOG_TELEMETRY_WRITE_BYTE(data) logTelemetryWriteByte(data)
+#if defined(LOG_TELEMETRY)
+#define LOG_TELEMETRY_WRITE_DATA(data, count) telemetryCaptureFrame(telemetryProtocol, data, count)
 #else
-#define LOG_TELEMETRY_WRITE_START()
-#define LOG_TELEMETRY_WRITE_BYTE(data)
+#define LOG_TELEMETRY_WRITE_DATA(data, count)
 #endif
 
 #define TELEMETRY_OUTPUT_FIFO_SIZE 16
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+
+enum TelemetryCaptureState {
+  CAPTURE_CLOSED,
+  CAPTURE_OPENED,
+  CAPTURE_ERROR,
+};
+
+// the mixer task queues the frames, the menus task writes them. The mixer task
+// is never interrupted by the menus task, so the fifo always holds whole frames
+static Fifo<uint8_t, TELEMETRY_CAPTURE_FIFO_SIZE> telemetryCaptureFifo;
+static FIL telemetryCaptureFile;
+static volatile uint8_t telemetryCaptureState = CAPTURE_CLOSED;
+static uint8_t telemetryCaptureLost;
+static uint8_t telemetryCaptureBlock[TELEMETRY_CAPTURE_BLOCK_SIZE];
+static uint32_t telemetryCaptureBlockSize;
+static tmr10ms_t telemetryCaptureSyncTime;
+static bool telemetryCaptureSyncNeeded;
+
+static uint32_t telemetryCaptureTime()
+{
+  static bool started = false;
+  static uint32_t time;
+  static uint16_t lastTmr2MHz;
+  static tmr10ms_t lastTmr10ms;
+
+  uint16_t tmr2MHz = getTmr2MHz();
+  tmr10ms_t tmr10ms = get_tmr10ms();
+
+  if (started) {
+    uint32_t delta = (uint16_t)(tmr2MHz - lastTmr2MHz);
+    // the 2MHz timer wraps every 32ms, the 10ms timer tells how many times it did
+    uint64_t elapsed = (uint64_t)(tmr10ms - lastTmr10ms) * 20000;
+    if (elapsed > delta) {
+      delta += (elapsed - delta + 0x8000) & ~(uint64_t)0xFFFF;
+    }
+    time += delta;
+  }
+
+  started = true;
+  lastTmr2MHz = tmr2MHz;
+  lastTmr10ms = tmr10ms;
+  return time;
+}
+
+void telemetryCaptureFrame(uint8_t protocol, const uint8_t * data, uint32_t count)
+{
+  if (telemetryCaptureState == CAPTURE_ERROR)
+    return;
+
+  TelemetryCaptureFrame frame;
+  frame.time = telemetryCaptureTime();
+
+  if (!telemetryCaptureFifo.hasSpace(sizeof(frame) + count)) {
+    if (telemetryCaptureLost < 255)
+      telemetryCaptureLost++;
+    return;
+  }
+
+  frame.protocol = protocol;
+  frame.lost = telemetryCaptureLost;
+  frame.length = count;
+  telemetryCaptureFifo.push((const uint8_t *)&frame, sizeof(frame));
+  telemetryCaptureFifo.push(data, count);
+  telemetryCaptureLost = 0;
+}
+
+static const char * telemetryCaptureOpen()
+{
+  char filename[48]; // /LOGS/TELEMETRY-2013-01-01-12-00-00.cap
+
+  if (sdGetFreeSectors() == 0)
+    return STR_SDCARD_FULL;
+
+  strcpy(filename, LOGS_PATH);
+  const char * error = sdCheckAndCreateDirectory(filename);
+  if (error) {
+    return error;
+  }
+
+  strcpy(filename, LOGS_PATH "/TELEMETRY");
+  char * tmp = &filename[sizeof(LOGS_PATH "/TELEMETRY")-1];
+#if defined(RTCLOCK)
+  tmp = strAppendDate(tmp, true);
+#endif
+  strcpy(tmp, TELEMETRY_CAPTURE_EXT);
+
+  FRESULT result = f_open(&telemetryCaptureFile, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  // the header is written with the first block, so that all the writes are sector aligned
+  TelemetryCaptureHeader header;
+  memclear(&header, sizeof(header));
+  header.fourcc = TELEMETRY_CAPTURE_FOURCC;
+  header.version = TELEMETRY_CAPTURE_VERSION;
+  memcpy(telemetryCaptureBlock, &header, sizeof(header));
+  telemetryCaptureBlockSize = sizeof(header);
+  telemetryCaptureSyncTime = get_tmr10ms();
+  telemetryCaptureSyncNeeded = false;
+
+  TRACE("Telemetry capture started (%s)", filename);
+  return NULL;
+}
+
+static void telemetryCaptureError()
+{
+  TRACE("Telemetry capture write error");
+  f_close(&telemetryCaptureFile);
+  telemetryCaptureState = CAPTURE_ERROR;
+}
+
+static bool telemetryCaptureWriteBlock()
+{
+  UINT written;
+  FRESULT result = f_write(&telemetryCaptureFile, telemetryCaptureBlock, telemetryCaptureBlockSize, &written);
+  if (result != FR_OK || written != telemetryCaptureBlockSize) {
+    telemetryCaptureError();
+    return false;
+  }
+  telemetryCaptureBlockSize = 0;
+  telemetryCaptureSyncNeeded = true;
+  return true;
+}
+
+void telemetryCaptureWrite()
+{
+  if (telemetryCaptureState == CAPTURE_ERROR)
+    return;
+
+  if (telemetryCaptureState == CAPTURE_CLOSED) {
+    if (telemetryCaptureFifo.isEmpty() || !sdMounted())
+      return;
+    const char * error = telemetryCaptureOpen();
+    if (error) {
+      TRACE("Telemetry capture error: %s", error);
+      telemetryCaptureState = CAPTURE_ERROR;
+      return;
+    }
+    telemetryCaptureState = CAPTURE_OPENED;
+  }
+
+  const uint8_t * data;
+  uint32_t count;
+  while ((count = telemetryCaptureFifo.getContiguousData(data)) > 0) {
+    count = min<uint32_t>(count, TELEMETRY_CAPTURE_BLOCK_SIZE - telemetryCaptureBlockSize);
+    memcpy(&telemetryCaptureBlock[telemetryCaptureBlockSize], data, count);
+    telemetryCaptureFifo.skip(count);
+    telemetryCaptureBlockSize += count;
+    if (telemetryCaptureBlockSize == TELEMETRY_CAPTURE_BLOCK_SIZE && !telemetryCaptureWriteBlock()) {
+      return;
+    }
+  }
+
+  // the file size in the directory is only updated by f_sync(), without it a
+  // crash during the capture would leave an empty file
+  if (telemetryCaptureSyncNeeded && (tmr10ms_t)(get_tmr10ms() - telemetryCaptureSyncTime) >= TELEMETRY_CAPTURE_SYNC_PERIOD) {
+    telemetryCaptureSyncTime = get_tmr10ms();
+    telemetryCaptureSyncNeeded = false;
+    if (f_sync(&telemetryCaptureFile) != FR_OK) {
+      telemetryCaptureError();
+    }
+  }
+}
+
+// Called before the SD card is unmounted, the next frames go to a new file
+void telemetryCaptureClose()
+{
+  if (telemetryCaptureState != CAPTURE_OPENED)
+    return;
+
+  telemetryCaptureWrite();
+
+  if (telemetryCaptureState == CAPTURE_OPENED) {
+    if (telemetryCaptureBlockSize == 0 || telemetryCaptureWriteBlock()) {
+      f_close(&telemetryCaptureFile);
+      telemetryCaptureState = CAPTURE_CLOSED;
+      TRACE("Telemetry capture stopped");
+    }
+  }
+}
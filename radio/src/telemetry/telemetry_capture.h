@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _TELEMETRY_CAPTURE_H_
+#define _TELEMETRY_CAPTURE_H_
+
+// Raw telemetry capture
+//
+// The telemetry data is captured as it is read from the receive fifo, each
+// record being one chunk of the fifo, timestamped with the 2MHz timer. A
+// chunk is what telemetryWakeup() found in the fifo: it may hold a part of a
+// protocol frame, or several frames. The mixer task queues the records in a
+// RAM fifo, the menus task writes them to the SD card by blocks of
+// TELEMETRY_CAPTURE_BLOCK_SIZE bytes, and syncs the file every second so that
+// it survives a crash or a power loss.
+//
+// File (/LOGS/TELEMETRY-<date>.cap): a TelemetryCaptureHeader, then for each
+// record a TelemetryCaptureFrame followed by its payload. All fields are
+// little endian.
+
+#define TELEMETRY_CAPTURE_FOURCC       0x5458544F // "OTXT"
+#define TELEMETRY_CAPTURE_VERSION      1
+#define TELEMETRY_CAPTURE_EXT          ".cap"
+
+PACK(struct TelemetryCaptureHeader {
+  uint32_t fourcc;
+  uint8_t  version;
+  uint8_t  spare[3];
+});
+
+PACK(struct TelemetryCaptureFrame {
+  uint32_t time;      // 0.5us unit, wraps every 35 minutes
+  uint8_t  protocol;  // telemetryProtocol when the data was received
+  uint8_t  lost;      // records lost just before this one (RAM fifo full)
+  uint16_t length;    // payload length
+});
+
+#if defined(LOG_TELEMETRY)
+#define TELEMETRY_CAPTURE_FIFO_SIZE    4096
+#define TELEMETRY_CAPTURE_BLOCK_SIZE   512
+#define TELEMETRY_CAPTURE_SYNC_PERIOD  100 // 10ms ticks
+
+void telemetryCaptureFrame(uint8_t protocol, const uint8_t * data, uint32_t count);
+void telemetryCaptureWrite();
+void telemetryCaptureClose();
+#endif
+
+#if defined(SIMU) && defined(STM32)
+// Replay of a capture into the telemetry pipeline, in the simulator and in
+// mixerbench. The text dumps of the former LOG_TELEMETRY ("<date>,<time>: 7E 98
+// 10 ..." lines, as read by radio/util/sport-parse.py) are accepted as well.
+// The original timing is divided by speed, 0 replays as fast as possible
+#define TELEMETRY_REPLAY_BURST         64 // frames per telemetryWakeup() when replaying as fast as possible
+
+struct TelemetryReplayStats {
+  uint32_t frames;
+  uint32_t bytes;
+  uint64_t decodeTime;    // ns spent in processTelemetryData()
+  uint64_t elapsedTime;   // ns since the start of the replay
+};
+
+const char * telemetryReplayStart(const char * path, uint32_t speed);
+void telemetryReplayStop();
+bool isTelemetryReplaying();
+void telemetryReplayWakeup();
+void telemetryReplayGetStats(TelemetryReplayStats & stats);
+#endif
+
+#endif // _TELEMETRY_CAPTURE_H_
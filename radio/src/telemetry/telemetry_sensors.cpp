@@ -22,6 +22,16 @@
 
 TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
 uint8_t allowNewSensors;
+sensors_mask_t telemetryItemsChanged;
+
+void markTelemetryItemChanged(uint8_t index)
+{
+  __disable_irq();
+  telemetryItemsChanged |= SENSOR_MASK(index);
+  __enable_irq();
+}
+
+static_assert(MAX_TELEMETRY_SENSORS <= 8 * sizeof(sensors_mask_t), "Sensors masks too small");
 
 bool isFaiForbidden(source_t idx)
 {
@@ -81,6 +91,11 @@ void TelemetryItem::setValue(const TelemetrySensor & sensor, int32_t val, uint32
 {
   int32_t newVal = val;
 
+  unsigned int index = this - telemetryItems;
+  if (index < MAX_TELEMETRY_SENSORS) {
+    markTelemetryItemChanged(index);
+  }
+
   if (unit == UNIT_CELLS) {
     uint32_t data = uint32_t(newVal);
     uint8_t cellsCount = (data >> 24);
@@ -266,6 +281,7 @@ void TelemetryItem::per10ms(const TelemetrySensor & sensor)
         }
         else if (currentItem.isOld()) {
           lastReceived = TELEMETRY_VALUE_OLD;
+          markTelemetryItemChanged(this - telemetryItems);
           return;
         }
         int32_t current = convertTelemetryValue(currentItem.value, currentSensor.unit, currentSensor.prec, UNIT_AMPS, 1);
@@ -275,6 +291,8 @@ void TelemetryItem::per10ms(const TelemetrySensor & sensor)
           setValue(sensor, value+1, sensor.unit, sensor.prec);
         }
         lastReceived = now();
+        // the sensors using it are kept fresh even when the value doesn't change
+        markTelemetryItemChanged(this - telemetryItems);
       }
       break;
 
@@ -450,6 +468,133 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
   }
 }
 
+static uint8_t calculatedSensorsOrder[MAX_TELEMETRY_SENSORS];
+static uint8_t calculatedSensorsCount;
+bool calculatedSensorsOrderDirty = true;
+static sensors_mask_t calculatedSensorsSources[MAX_TELEMETRY_SENSORS];
+static sensors_mask_t calculatedSensorsLoop;
+
+static sensors_mask_t sensorSourceMask(int source)
+{
+  source = abs(source);
+  if (source > 0 && source <= MAX_TELEMETRY_SENSORS)
+    return SENSOR_MASK(source - 1);
+  else
+    return 0;
+}
+
+/**
+  @brief Returns the sensors used by TelemetryItem::eval() for the given sensor
+*/
+static sensors_mask_t calculatedSensorDependencies(uint8_t idx)
+{
+  const TelemetrySensor & sensor = g_model.telemetrySensors[idx];
+  if (sensor.type != TELEM_TYPE_CALCULATED)
+    return 0;
+
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      return sensorSourceMask(sensor.cell.source);
+
+    case TELEM_FORMULA_DIST:
+      return sensorSourceMask(sensor.dist.gps) | sensorSourceMask(sensor.dist.alt);
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY:
+    {
+      sensors_mask_t result = 0;
+      int maxitems = (sensor.formula == TELEM_FORMULA_MULTIPLY ? 2 : 4);
+      for (int i=0; i<maxitems; i++) {
+        result |= sensorSourceMask(sensor.calc.sources[i]);
+      }
+      return result;
+    }
+
+    default:
+      // consumption and totalize are updated when their source changes
+      return 0;
+  }
+}
+
+/**
+  @brief Sorts the calculated sensors so that each one is evaluated after its sources
+*/
+void buildCalculatedSensorsOrder()
+{
+  // cleared first, so that a modification done while we are building is not lost
+  calculatedSensorsOrderDirty = false;
+
+  sensors_mask_t done = ~(sensors_mask_t)0;
+  for (uint8_t idx=0; idx<MAX_TELEMETRY_SENSORS; idx++) {
+    calculatedSensorsSources[idx] = calculatedSensorDependencies(idx);
+    if (calculatedSensorsSources[idx]) {
+      done &= ~SENSOR_MASK(idx);
+    }
+  }
+
+  uint8_t count = 0;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (uint8_t idx=0; idx<MAX_TELEMETRY_SENSORS; idx++) {
+      if (!(done & SENSOR_MASK(idx)) && !(calculatedSensorsSources[idx] & ~done)) {
+        calculatedSensorsOrder[count++] = idx;
+        done |= SENSOR_MASK(idx);
+        progress = true;
+      }
+    }
+  }
+
+  // the sensors left are part of a loop, they will read the values of the previous evaluation
+  calculatedSensorsLoop = ~done;
+  for (uint8_t idx=0; idx<MAX_TELEMETRY_SENSORS; idx++) {
+    if (!(done & SENSOR_MASK(idx))) {
+      TRACE("Sensor %d is part of a loop", idx+1);
+      calculatedSensorsOrder[count++] = idx;
+    }
+  }
+  calculatedSensorsCount = count;
+
+  // everything is evaluated again with the new configuration
+  __disable_irq();
+  telemetryItemsChanged = ~(sensors_mask_t)0;
+  __enable_irq();
+}
+
+/**
+  @brief Evaluates the calculated sensors whose sources changed since the last call
+*/
+void evalCalculatedSensors()
+{
+  if (calculatedSensorsOrderDirty) {
+    buildCalculatedSensorsOrder();
+  }
+
+  __disable_irq();
+  sensors_mask_t changed = telemetryItemsChanged;
+  telemetryItemsChanged = 0;
+  __enable_irq();
+  sensors_mask_t evaluated = 0;
+
+  for (uint8_t i=0; i<calculatedSensorsCount; i++) {
+    uint8_t idx = calculatedSensorsOrder[i];
+    if (calculatedSensorsSources[idx] & changed) {
+      telemetryItems[idx].eval(g_model.telemetrySensors[idx]);
+      // the sensors using this one are evaluated in the same pass
+      changed |= SENSOR_MASK(idx);
+      evaluated |= SENSOR_MASK(idx);
+    }
+  }
+
+  // except in a loop, the sensors evaluated are up to date with their sources
+  __disable_irq();
+  telemetryItemsChanged &= ~(evaluated & ~calculatedSensorsLoop);
+  __enable_irq();
+}
+
 void delTelemetryIndex(uint8_t index)
 {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
@@ -499,17 +644,89 @@ bool isValidIdAndInstance(uint16_t id, uint8_t instance)
   return true;
 }
 
+#define TELEMETRY_SENSORS_INDEX_BITS   7
+#define TELEMETRY_SENSORS_INDEX_SIZE   (1 << TELEMETRY_SENSORS_INDEX_BITS)
+
+static_assert(TELEMETRY_SENSORS_INDEX_SIZE >= 2 * MAX_TELEMETRY_SENSORS, "Telemetry sensors index too small");
+
+// Open addressing (linear probing) on the sensors keys. Each entry is the
+// first sensor (index+1, 0 when empty) of the list of sensors sharing the same
+// key, the next ones are linked in ascending order through telemetrySensorsNext[].
+// When the ids are ignored the instance is not part of the key
+static uint8_t telemetrySensorsIndex[TELEMETRY_SENSORS_INDEX_SIZE];
+static uint8_t telemetrySensorsNext[MAX_TELEMETRY_SENSORS];
+static bool telemetrySensorsIndexIgnoreIds;
+bool telemetrySensorsIndexDirty = true;
+
+static inline bool isTelemetrySensorMatching(const TelemetrySensor & sensor, uint16_t id, uint8_t subId, uint8_t instance, bool ignoreIds)
+{
+  return sensor.type == TELEM_TYPE_CUSTOM && sensor.id == id && sensor.subId == subId && (sensor.instance == instance || ignoreIds);
+}
+
+static inline uint32_t getTelemetrySensorsIndexSlot(uint16_t id, uint8_t subId, uint8_t instance, bool ignoreIds)
+{
+  uint32_t key = ((uint32_t)id << 16) + (subId << 8) + (ignoreIds ? 0 : instance);
+  return (key * 2654435761u) >> (32 - TELEMETRY_SENSORS_INDEX_BITS);
+}
+
+void buildTelemetrySensorsIndex()
+{
+  // cleared first, so that a modification done while we are building is not lost
+  telemetrySensorsIndexDirty = false;
+
+  bool ignoreIds = g_model.ignoreSensorIds;
+  telemetrySensorsIndexIgnoreIds = ignoreIds;
+  memclear(telemetrySensorsIndex, sizeof(telemetrySensorsIndex));
+  memclear(telemetrySensorsNext, sizeof(telemetrySensorsNext));
+
+  for (int index=0; index<MAX_TELEMETRY_SENSORS; index++) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    if (sensor.type != TELEM_TYPE_CUSTOM)
+      continue;
+    uint32_t slot = getTelemetrySensorsIndexSlot(sensor.id, sensor.subId, sensor.instance, ignoreIds);
+    while (telemetrySensorsIndex[slot]) {
+      int first = telemetrySensorsIndex[slot] - 1;
+      if (isTelemetrySensorMatching(g_model.telemetrySensors[first], sensor.id, sensor.subId, sensor.instance, ignoreIds)) {
+        // same key as a previous sensor, added at the end of its list
+        int last = first;
+        while (telemetrySensorsNext[last])
+          last = telemetrySensorsNext[last] - 1;
+        telemetrySensorsNext[last] = index + 1;
+        break;
+      }
+      slot = (slot + 1) & (TELEMETRY_SENSORS_INDEX_SIZE - 1);
+    }
+    if (!telemetrySensorsIndex[slot]) {
+      telemetrySensorsIndex[slot] = index + 1;
+    }
+  }
+}
+
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId, uint8_t instance, int32_t value, uint32_t unit, uint32_t prec)
 {
   bool available = false;
 
-  for (int index=0; index<MAX_TELEMETRY_SENSORS; index++) {
-    TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
-    if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id && telemetrySensor.subId == subId && (telemetrySensor.instance == instance || g_model.ignoreSensorIds)) {
-      telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
-      available = true;
-      // we continue search here, because sensors can share the same id and instance
+  if (telemetrySensorsIndexDirty || telemetrySensorsIndexIgnoreIds != g_model.ignoreSensorIds) {
+    buildTelemetrySensorsIndex();
+  }
+
+  // the keys are checked again, the index may be stale until it is rebuilt
+  bool ignoreIds = telemetrySensorsIndexIgnoreIds;
+  uint32_t slot = getTelemetrySensorsIndexSlot(id, subId, instance, ignoreIds);
+  for (int probe=0; probe<TELEMETRY_SENSORS_INDEX_SIZE && telemetrySensorsIndex[slot]; probe++) {
+    int index = telemetrySensorsIndex[slot] - 1;
+    if (isTelemetrySensorMatching(g_model.telemetrySensors[index], id, subId, instance, ignoreIds)) {
+      // sensors can share the same id and instance
+      for (; index>=0; index=telemetrySensorsNext[index]-1) {
+        TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
+        if (isTelemetrySensorMatching(telemetrySensor, id, subId, instance, ignoreIds)) {
+          telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
+          available = true;
+        }
+      }
+      break;
     }
+    slot = (slot + 1) & (TELEMETRY_SENSORS_INDEX_SIZE - 1);
   }
 
   if (available || !allowNewSensors) {
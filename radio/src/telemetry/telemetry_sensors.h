@@ -28,6 +28,15 @@
 #define TELEMETRY_VALUE_UNAVAILABLE    255
 #define TELEMETRY_VALUE_OLD            254
 
+typedef uint64_t sensors_mask_t;
+#define SENSOR_MASK(idx)               ((sensors_mask_t)1 << (idx))
+
+// Sensors which received a value, or became old, since the last evaluation of the calculated sensors.
+// Updated from the mixer task, the menus task (Lua) and the 10ms interrupt, always with the
+// interrupts disabled, as the read-modify-write of a 64 bits value is not atomic
+extern sensors_mask_t telemetryItemsChanged;
+void markTelemetryItemChanged(uint8_t index);
+
 class TelemetryItem
 {
   public:
@@ -139,4 +148,32 @@ extern uint8_t allowNewSensors;
 bool isFaiForbidden(source_t idx);
 bool isValidIdAndInstance(uint16_t id, uint8_t instance);
 
+// The protocols sensors descriptors tables are sorted on their key(), so that
+// they are searched with a fixed number of steps. The order is checked at compile
+// time with static_assert(isSensorsTableSorted(table), ...)
+template <class T, size_t N>
+constexpr bool isSensorsTableSorted(const T (&table)[N], size_t index = 1)
+{
+  return index >= N || (table[index-1].key() <= table[index].key() && isSensorsTableSorted(table, index + 1));
+}
+
+// Returns the first descriptor whose key is not less than key, or the end of the table
+template <class T, size_t N>
+const T * findSensorDescriptor(const T (&table)[N], uint32_t key)
+{
+  size_t first = 0;
+  size_t count = N;
+  while (count > 0) {
+    size_t step = count / 2;
+    if (table[first + step].key() < key) {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else {
+      count = step;
+    }
+  }
+  return &table[first];
+}
+
 #endif // _TELEMETRY_SENSORS_H_
@@ -109,6 +109,9 @@ void setCurve(uint8_t c, const pm_int8_t ar[])
   for (uint8_t i=0; i<5; i++) {
     cv[i] = pgm_read_byte(&ar[i]);
   }
+#if defined(CPUARM)
+  invalidateCurveLut(c);
+#endif
 }
 #endif
 
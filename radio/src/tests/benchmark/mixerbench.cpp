@@ -0,0 +1,587 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+/*
+ * Host side mixer benchmark
+ *
+ * Usage: mixerbench [-n <cycles>] <models directory>
+ *        mixerbench -r <inputs record> [-o <outputs trace>] <model file>
+ *        mixerbench -t <telemetry capture> <model file>
+ *        mixerbench -g <NMEA log>
+ *        mixerbench -c
+ *
+ * Every model file (.bin, as saved on the SD card or extracted from the
+ * MODELS/ folder of a .otx archive, same version as the benchmark) is loaded
+ * and doMixerCalculations() is run <cycles> times with the sticks sweeping
+ * their full range. Each cycle is a 10ms tick, so the 10ms stages are always
+ * included. The results are written on stdout as JSON, the firmware traces
+ * being sent to stderr so that they don't mix with them.
+ *
+ * With -r (INPUTS_RECORDER builds) the mixer is fed with the cycles of an
+ * inputs record instead, as fast as possible. The channelOutputs of each
+ * cycle are written to the trace file (int16 little endian, MAX_OUTPUT_CHANNELS
+ * per cycle), so that two builds can be compared with cmp.
+ *
+ * With -t the frames of a telemetry capture (or of a text dump made by the
+ * former LOG_TELEMETRY) are fed to telemetryWakeup() as fast as possible,
+ * and the frames rate and the decoding time per frame are written instead.
+ *
+ * With -g (INTERNAL_GPS builds) a recorded NMEA log (raw output of the GPS
+ * receiver, as printed by the "gps trace" CLI command) is fed to the NMEA
+ * parser by chunks of the GPS receive fifo size, until GPS_BENCHMARK_BYTES
+ * have been parsed, and the parsing time per byte and per sentence is written.
+ *
+ * With -c the CRCs of the protocols are computed over CRC_BENCHMARK_BYTES, by
+ * frames of CRC_BENCHMARK_FRAME bytes, both with the CRC engine (slice-by-8 on
+ * the host) and byte by byte as on the radio, and the time per byte is written.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "opentx.h"
+
+// after ff.h, as in simufatfs.cpp, the FatFs DIR is not the POSIX one
+namespace simu {
+#include <dirent.h>
+}
+
+#define DEFAULT_CYCLES   10000
+#define GPS_BENCHMARK_BYTES   (16*1024*1024)
+#define GPS_BENCHMARK_CHUNK   64
+#define CRC_BENCHMARK_BYTES   (16*1024*1024)
+#define CRC_BENCHMARK_FRAME   26
+
+// the JSON results, stdout being the traces output
+FILE * jsonOutput = stdout;
+
+uint64_t benchmarkStageStart[BENCHMARK_STAGES_COUNT];
+uint64_t benchmarkStageTime[BENCHMARK_STAGES_COUNT];
+
+const char * const benchmarkStageNames[BENCHMARK_STAGES_COUNT] = {
+  "evalInputs",
+  "evalLogicalSwitches",
+  "evalFunctions",
+  "applyLimits",
+};
+
+uint64_t benchmarkGetNanos()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint16_t anaInValues[NUM_STICKS+NUM_POTS+NUM_SLIDERS] = { 0 };
+uint16_t anaIn(uint8_t chan)
+{
+  if (chan < NUM_STICKS+NUM_POTS+NUM_SLIDERS)
+    return anaInValues[chan];
+  else
+    return 0;
+}
+
+uint16_t getAnalogValue(uint8_t index)
+{
+  return anaIn(index);
+}
+
+const char * loadModelFile(const char * path)
+{
+  FILE * file = fopen(path, "rb");
+  if (!file) {
+    return "can't open file";
+  }
+
+  uint8_t header[8];
+  if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
+    fclose(file);
+    return "file too short";
+  }
+
+  uint32_t fourcc = *(uint32_t *)&header[0];
+  if ((fourcc != OTX_FOURCC && fourcc != O9X_FOURCC) || header[5] != 'M') {
+    fclose(file);
+    return "not a model file for this radio";
+  }
+  if (header[4] != EEPROM_VER) {
+    // no conversions here, the model must be saved by the same version
+    fclose(file);
+    return "model version mismatch";
+  }
+
+  uint16_t size = *(uint16_t *)&header[6];
+  if (size != sizeof(g_model)) {
+    // the RLC compressed backups of the EEPROM radios are not supported
+    fclose(file);
+    return "model size mismatch";
+  }
+
+  preModelLoad();
+  if (fread(&g_model, 1, size, file) != size) {
+    fclose(file);
+    return "file too short";
+  }
+  fclose(file);
+
+  extern uint8_t s_mixer_first_run_done;
+  s_mixer_first_run_done = false;
+  lastFlightMode = 255;
+  postModelLoad(false);
+  return NULL;
+}
+
+// triangle sweep of the sticks, each one with its own phase and period
+void sweepSticks(uint32_t cycle)
+{
+  for (uint8_t i=0; i<NUM_STICKS; i++) {
+    uint32_t period = 200 + 50 * i;
+    int32_t position = (cycle + i * period / NUM_STICKS) % period;
+    int32_t value = position < (int32_t)period / 2 ? position : period - position;
+    anaInValues[i] = -RESX + value * 4 * RESX / period;
+  }
+}
+
+struct BenchmarkResult {
+  std::string filename;
+  std::string error;
+  char name[LEN_MODEL_NAME+1];
+  uint32_t cycles;
+  uint64_t total;
+  uint64_t stages[BENCHMARK_STAGES_COUNT];
+};
+
+void benchmarkModel(BenchmarkResult & result, const char * path, uint32_t cycles)
+{
+  result.cycles = cycles;
+  result.total = 0;
+  memclear(result.name, sizeof(result.name));
+  memclear(result.stages, sizeof(result.stages));
+
+  const char * error = loadModelFile(path);
+  if (error) {
+    result.error = error;
+    return;
+  }
+  zchar2str(result.name, g_model.header.name, LEN_MODEL_NAME);
+
+  // warm up, the mixer plan and the curves tables are built during the first cycles
+  for (uint32_t i=0; i<10; i++) {
+    g_tmr10ms++;
+    doMixerCalculations();
+  }
+
+  memclear(benchmarkStageTime, sizeof(benchmarkStageTime));
+  for (uint32_t i=0; i<cycles; i++) {
+    sweepSticks(i);
+    g_tmr10ms++;
+    uint64_t start = benchmarkGetNanos();
+    doMixerCalculations();
+    result.total += benchmarkGetNanos() - start;
+  }
+  memcpy(result.stages, benchmarkStageTime, sizeof(result.stages));
+}
+
+#if defined(INPUTS_RECORDER)
+const char * replayRecord(BenchmarkResult & result, const char * recordPath, const char * tracePath)
+{
+  FILE * file = fopen(recordPath, "rb");
+  if (!file) {
+    return "can't open record";
+  }
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t len;
+  while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + len);
+  }
+  fclose(file);
+
+  RecordHeader header;
+  if (data.size() < sizeof(header)) {
+    return "record too short";
+  }
+  memcpy(&header, data.data(), sizeof(header));
+  if (header.fourcc != RECORD_FOURCC || header.version != RECORD_VERSION || header.wordsCount != RECORD_SNAPSHOT_WORDS) {
+    return "record not made on this radio";
+  }
+  g_eeGeneral.stickMode = header.stickMode;
+
+  FILE * trace = NULL;
+  if (tracePath) {
+    trace = fopen(tracePath, "wb");
+    if (!trace) {
+      return "can't create trace";
+    }
+  }
+
+  RecordSnapshot snapshot;
+  memclear(&snapshot, sizeof(snapshot));
+  const uint8_t * cur = data.data() + sizeof(header);
+  const uint8_t * end = data.data() + data.size();
+  const char * error = NULL;
+
+  memclear(benchmarkStageTime, sizeof(benchmarkStageTime));
+  result.cycles = 0;
+  while (cur < end) {
+    uint8_t ticks;
+    cur = recordDecodeFrame(cur, end, snapshot, ticks);
+    if (!cur) {
+      error = "truncated record";
+      break;
+    }
+    for (uint8_t i=0; i<RECORD_ANALOGS_COUNT; i++) {
+      anaInValues[i] = snapshot.words[RECORD_OFFSET_ANALOGS+i];
+    }
+    recordApply(snapshot);
+    g_tmr10ms += ticks;
+
+    uint64_t start = benchmarkGetNanos();
+    doMixerCalculations();
+    result.total += benchmarkGetNanos() - start;
+    result.cycles++;
+
+    if (trace) {
+      uint8_t outputs[2*MAX_OUTPUT_CHANNELS];
+      for (int i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+        outputs[2*i] = channelOutputs[i];
+        outputs[2*i+1] = channelOutputs[i] >> 8;
+      }
+      fwrite(outputs, 1, sizeof(outputs), trace);
+    }
+  }
+  memcpy(result.stages, benchmarkStageTime, sizeof(result.stages));
+
+  if (trace) {
+    fclose(trace);
+  }
+  return (result.cycles == 0 && !error) ? "empty record" : error;
+}
+#endif
+
+#if defined(STM32)
+const char * replayTelemetry(const char * capturePath, TelemetryReplayStats & stats)
+{
+  telemetryInit(modelTelemetryProtocol());
+  const char * error = telemetryReplayStart(capturePath, 0);
+  if (error) {
+    return error;
+  }
+  while (isTelemetryReplaying()) {
+    g_tmr10ms++;
+    telemetryWakeup();
+  }
+  telemetryReplayGetStats(stats);
+  return NULL;
+}
+#endif
+
+#if defined(INTERNAL_GPS)
+const char * parseNMEALog(const char * logPath, uint64_t & bytes, uint64_t & time)
+{
+  FILE * file = fopen(logPath, "rb");
+  if (!file) {
+    return "can't open NMEA log";
+  }
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t len;
+  while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + len);
+  }
+  fclose(file);
+
+  if (data.empty()) {
+    return "empty NMEA log";
+  }
+
+  memclear(&gpsData, sizeof(gpsData));
+  bytes = 0;
+  time = 0;
+  while (bytes < GPS_BENCHMARK_BYTES) {
+    uint64_t start = benchmarkGetNanos();
+    for (uint32_t i=0; i<data.size(); i+=GPS_BENCHMARK_CHUNK) {
+      gpsNewFrameNMEA(&data[i], min<uint32_t>(GPS_BENCHMARK_CHUNK, data.size()-i));
+    }
+    time += benchmarkGetNanos() - start;
+    bytes += data.size();
+  }
+  return NULL;
+}
+#endif
+
+template <class crc_t, const crc_t * table>
+void benchmarkCrc(const char * name, bool first)
+{
+  typedef Crc<crc_t, table> Engine;
+  static uint8_t data[CRC_BENCHMARK_BYTES];
+  for (uint32_t i=0; i<CRC_BENCHMARK_BYTES; i++) {
+    data[i] = i * 37 + (i >> 8);
+  }
+
+  uint32_t result = 0;
+  uint64_t start = benchmarkGetNanos();
+  for (uint32_t i=0; i+CRC_BENCHMARK_FRAME<=CRC_BENCHMARK_BYTES; i+=CRC_BENCHMARK_FRAME) {
+    result += Engine::compute(&data[i], CRC_BENCHMARK_FRAME);
+  }
+  uint64_t engineTime = benchmarkGetNanos() - start;
+
+  start = benchmarkGetNanos();
+  for (uint32_t i=0; i+CRC_BENCHMARK_FRAME<=CRC_BENCHMARK_BYTES; i+=CRC_BENCHMARK_FRAME) {
+    crc_t crc = 0;
+    for (uint32_t j=0; j<CRC_BENCHMARK_FRAME; j++) {
+      crc = Engine::update(crc, data[i+j]);
+    }
+    result -= crc;
+  }
+  uint64_t bytewiseTime = benchmarkGetNanos() - start;
+
+  fprintf(jsonOutput, "%s\n    {\"name\": \"%s\", \"ns_per_byte\": %.2f, \"bytewise_ns_per_byte\": %.2f, \"match\": %s}", first ? "" : ",", name,
+         (double)engineTime / CRC_BENCHMARK_BYTES, (double)bytewiseTime / CRC_BENCHMARK_BYTES, result == 0 ? "true" : "false");
+}
+
+void printJsonString(const char * value)
+{
+  fputc('"', jsonOutput);
+  for (const char * c=value; *c; c++) {
+    if (*c == '"' || *c == '\\')
+      fprintf(jsonOutput, "\\%c", *c);
+    else if ((uint8_t)*c < 0x20)
+      fprintf(jsonOutput, "\\u%04x", *c);
+    else
+      fputc(*c, jsonOutput);
+  }
+  fputc('"', jsonOutput);
+}
+
+void printResults(const std::vector<BenchmarkResult> & results)
+{
+  fprintf(jsonOutput, "{\n  \"models\": [");
+  for (unsigned int i=0; i<results.size(); i++) {
+    const BenchmarkResult & result = results[i];
+    fprintf(jsonOutput, "%s\n    {\"file\": ", i > 0 ? "," : "");
+    printJsonString(result.filename.c_str());
+    if (!result.error.empty()) {
+      fprintf(jsonOutput, ", \"error\": ");
+      printJsonString(result.error.c_str());
+      fprintf(jsonOutput, "}");
+      continue;
+    }
+    fprintf(jsonOutput, ", \"name\": ");
+    printJsonString(result.name);
+    fprintf(jsonOutput, ", \"cycles\": %u, \"ns_per_cycle\": %llu, \"stages\": {", result.cycles, (unsigned long long)(result.total / result.cycles));
+    for (int stage=0; stage<BENCHMARK_STAGES_COUNT; stage++) {
+      fprintf(jsonOutput, "%s\"%s\": %llu", stage > 0 ? ", " : "", benchmarkStageNames[stage], (unsigned long long)(result.stages[stage] / result.cycles));
+    }
+    fprintf(jsonOutput, "}}");
+  }
+  fprintf(jsonOutput, "\n  ]\n}\n");
+}
+
+int main(int argc, char ** argv)
+{
+  uint32_t cycles = DEFAULT_CYCLES;
+  const char * directory = NULL;
+#if defined(INPUTS_RECORDER)
+  const char * record = NULL;
+  const char * trace = NULL;
+#endif
+#if defined(STM32)
+  const char * capture = NULL;
+#endif
+#if defined(INTERNAL_GPS)
+  const char * nmea = NULL;
+#endif
+  bool crc = false;
+
+  for (int i=1; i<argc; i++) {
+    if (!strcmp(argv[i], "-n") && i+1 < argc) {
+      cycles = strtoul(argv[++i], NULL, 10);
+    }
+#if defined(INPUTS_RECORDER)
+    else if (!strcmp(argv[i], "-r") && i+1 < argc) {
+      record = argv[++i];
+    }
+    else if (!strcmp(argv[i], "-o") && i+1 < argc) {
+      trace = argv[++i];
+    }
+#endif
+#if defined(STM32)
+    else if (!strcmp(argv[i], "-t") && i+1 < argc) {
+      capture = argv[++i];
+    }
+#endif
+#if defined(INTERNAL_GPS)
+    else if (!strcmp(argv[i], "-g") && i+1 < argc) {
+      nmea = argv[++i];
+    }
+#endif
+    else if (!strcmp(argv[i], "-c")) {
+      crc = true;
+    }
+    else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+      fprintf(stderr, "%s: option %s not supported in this build\n", argv[0], argv[i]);
+      return 1;
+    }
+    else {
+      directory = argv[i];
+    }
+  }
+
+#if defined(INTERNAL_GPS)
+  bool noInput = (!directory && !nmea && !crc);
+#else
+  bool noInput = (!directory && !crc);
+#endif
+  if (noInput || cycles == 0) {
+    fprintf(stderr, "Usage: %s [-n <cycles>] <models directory>\n", argv[0]);
+#if defined(INPUTS_RECORDER)
+    fprintf(stderr, "       %s -r <inputs record> [-o <outputs trace>] <model file>\n", argv[0]);
+#endif
+#if defined(STM32)
+    fprintf(stderr, "       %s -t <telemetry capture> <model file>\n", argv[0]);
+#endif
+#if defined(INTERNAL_GPS)
+    fprintf(stderr, "       %s -g <NMEA log>\n", argv[0]);
+#endif
+    fprintf(stderr, "       %s -c\n", argv[0]);
+    return 1;
+  }
+
+  // debugPrintf() always writes the traces on stdout, which becomes stderr,
+  // the results keeping the original stdout
+  jsonOutput = fdopen(dup(STDOUT_FILENO), "w");
+  dup2(STDERR_FILENO, STDOUT_FILENO);
+
+  simuInit();
+  StartEepromThread(NULL);
+  generalDefault();
+  g_eeGeneral.templateSetup = 0;
+#if defined(PCBTARANIS) || defined(PCBHORUS)
+  g_eeGeneral.switchConfig = 0x00007bff;
+#endif
+  if (g_tmr10ms == 0) {
+    g_tmr10ms = 1;
+  }
+
+#if defined(INPUTS_RECORDER)
+  if (record) {
+    // directory is the model file here
+    std::vector<BenchmarkResult> results(1);
+    BenchmarkResult & result = results[0];
+    result.filename = directory;
+    result.total = 0;
+    memclear(result.name, sizeof(result.name));
+    const char * error = loadModelFile(directory);
+    if (!error) {
+      zchar2str(result.name, g_model.header.name, LEN_MODEL_NAME);
+      error = replayRecord(result, record, trace);
+    }
+    if (error) {
+      result.error = error;
+    }
+    printResults(results);
+    return error ? 1 : 0;
+  }
+#endif
+
+#if defined(STM32)
+  if (capture) {
+    // directory is the model file here
+    TelemetryReplayStats stats;
+    const char * error = loadModelFile(directory);
+    if (!error) {
+      error = replayTelemetry(capture, stats);
+    }
+    fprintf(jsonOutput, "{\n  \"telemetry\": {\"file\": ");
+    printJsonString(capture);
+    if (error) {
+      fprintf(jsonOutput, ", \"error\": ");
+      printJsonString(error);
+    }
+    else {
+      fprintf(jsonOutput, ", \"frames\": %u, \"bytes\": %u, \"frames_per_s\": %llu, \"decode_ns_per_frame\": %llu",
+             stats.frames, stats.bytes,
+             (unsigned long long)(stats.frames * 1000000000ULL / max<uint64_t>(stats.elapsedTime, 1)),
+             (unsigned long long)(stats.decodeTime / stats.frames));
+    }
+    fprintf(jsonOutput, "}\n}\n");
+    return error ? 1 : 0;
+  }
+#endif
+
+#if defined(INTERNAL_GPS)
+  if (nmea) {
+    uint64_t bytes, time;
+    const char * error = parseNMEALog(nmea, bytes, time);
+    fprintf(jsonOutput, "{\n  \"gps\": {\"file\": ");
+    printJsonString(nmea);
+    if (error) {
+      fprintf(jsonOutput, ", \"error\": ");
+      printJsonString(error);
+    }
+    else {
+      fprintf(jsonOutput, ", \"bytes\": %llu, \"sentences\": %u, \"errors\": %u, \"ns_per_byte\": %.2f, \"ns_per_sentence\": %llu",
+             (unsigned long long)bytes, gpsData.packetCount, gpsData.errorCount, (double)time / bytes,
+             (unsigned long long)(time / max<uint32_t>(gpsData.packetCount, 1)));
+    }
+    fprintf(jsonOutput, "}\n}\n");
+    return error ? 1 : 0;
+  }
+#endif
+
+  if (crc) {
+    fprintf(jsonOutput, "{\n  \"crc\": [");
+    benchmarkCrc<uint8_t, crc8tab>("crc8", true);
+    benchmarkCrc<uint16_t, crc16tab>("crc16", false);
+    benchmarkCrc<uint16_t, crc16tabPxx>("pxx", false);
+    fprintf(jsonOutput, "\n  ]\n}\n");
+    return 0;
+  }
+
+  simu::DIR * dir = simu::opendir(directory);
+  if (!dir) {
+    fprintf(stderr, "Can't open directory %s\n", directory);
+    return 1;
+  }
+
+  std::vector<std::string> filenames;
+  while (struct simu::dirent * entry = simu::readdir(dir)) {
+    const char * ext = strrchr(entry->d_name, '.');
+    if (ext && !strcasecmp(ext, MODELS_EXT)) {
+      filenames.push_back(entry->d_name);
+    }
+  }
+  simu::closedir(dir);
+  std::sort(filenames.begin(), filenames.end());
+
+  std::vector<BenchmarkResult> results(filenames.size());
+  for (unsigned int i=0; i<filenames.size(); i++) {
+    results[i].filename = filenames[i];
+    std::string path = std::string(directory) + "/" + filenames[i];
+    benchmarkModel(results[i], path.c_str(), cycles);
+  }
+
+  printResults(results);
+  return 0;
+}
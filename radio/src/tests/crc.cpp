@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(CPUARM)
+static const uint8_t crcCheck[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+// the former byte by byte implementations
+template <class crc_t>
+crc_t crcReference(const crc_t * table, const uint8_t * data, uint32_t len)
+{
+  crc_t crc = 0;
+  for (uint32_t i=0; i<len; i++) {
+    crc = (crc << 8) ^ table[((crc >> (8*sizeof(crc_t)-8)) ^ data[i]) & 0xFF];
+  }
+  return crc;
+}
+
+template <class crc_t>
+crc_t crcBitwise(crc_t polynomial, const uint8_t * data, uint32_t len)
+{
+  const crc_t msb = 1 << (8*sizeof(crc_t)-1);
+  crc_t crc = 0;
+  for (uint32_t i=0; i<len; i++) {
+    crc ^= data[i] << (8*sizeof(crc_t)-8);
+    for (int bit=0; bit<8; bit++) {
+      crc = (crc & msb) ? (crc << 1) ^ polynomial : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+template <class Engine, class crc_t>
+void checkCrcEngine(const crc_t * table)
+{
+  uint8_t data[100];
+  for (unsigned int i=0; i<sizeof(data); i++) {
+    data[i] = i * 37 + 11;
+  }
+  for (uint32_t len=0; len<=sizeof(data); len++) {
+    crc_t reference = crcReference(table, data, len);
+    EXPECT_EQ(reference, Engine::compute(data, len)) << "length " << len;
+    crc_t crc = 0;
+    for (uint32_t i=0; i<len; i++) {
+      crc = Engine::update(crc, data[i]);
+    }
+    EXPECT_EQ(reference, crc) << "length " << len;
+    for (uint32_t split=1; split<len; split+=7) {
+      EXPECT_EQ(reference, Engine::compute(data+split, len-split, Engine::compute(data, split))) << "length " << len << " split " << split;
+    }
+  }
+}
+
+TEST(Crc, crc8)
+{
+  for (int i=0; i<256; i++) {
+    uint8_t byte = i;
+    ASSERT_EQ(crc8tab[i], crcBitwise<uint8_t>(0xD5, &byte, 1));
+  }
+  EXPECT_EQ(0xBC, crc8(crcCheck, sizeof(crcCheck)));
+  checkCrcEngine<Crc8>(crc8tab);
+}
+
+TEST(Crc, crc16)
+{
+  for (int i=0; i<256; i++) {
+    uint8_t byte = i;
+    ASSERT_EQ(crc16tab[i], crcBitwise<uint16_t>(0x1021, &byte, 1));
+  }
+  EXPECT_EQ(0x31C3, crc16(crcCheck, sizeof(crcCheck)));
+  checkCrcEngine<Crc16>(crc16tab);
+}
+
+TEST(Crc, crcPxx)
+{
+  EXPECT_EQ(0x604A, CrcPxx::compute(crcCheck, sizeof(crcCheck)));
+  checkCrcEngine<CrcPxx>(crc16tabPxx);
+}
+
+TEST(Crc, sportChecksum)
+{
+  uint8_t data[FRSKY_SPORT_PACKET_SIZE];
+  for (int seed=0; seed<256; seed++) {
+    uint16_t sum = 0;
+    for (int i=0; i<FRSKY_SPORT_PACKET_SIZE; i++) {
+      data[i] = seed * 13 + i * 251;
+      sum += data[i];
+      sum += sum >> 8;
+      sum &= 0xFF;
+    }
+    EXPECT_EQ(sum, sportChecksum(data, FRSKY_SPORT_PACKET_SIZE));
+  }
+}
+#endif
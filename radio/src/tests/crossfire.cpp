@@ -43,5 +43,70 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+
+TEST(Crossfire, telemetryChunks)
+{
+  uint8_t frames[] = {
+    RADIO_ADDRESS, 0x0A, BATTERY_ID, 0x00, 0x7B, 0x00, 0x0C, 0x00, 0x01, 0x2C, 0x50, 0x00,
+    RADIO_ADDRESS, 0x0A, BATTERY_ID, 0x00, 0x7A, 0x00, 0x0D, 0x00, 0x01, 0x2D, 0x50, 0x00,
+  };
+  frames[11] = crc8(&frames[2], frames[1]-1);
+  frames[23] = crc8(&frames[14], frames[13]-1);
+
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+  telemetryRxBufferCount = 0;
+
+  // a frame split over two chunks
+  processCrossfireTelemetryData(frames, 5);
+  processCrossfireTelemetryData(frames+5, 7);
+  EXPECT_EQ(telemetryItems[0].value, 123);
+  EXPECT_EQ(telemetryItems[1].value, 12);
+  EXPECT_EQ(telemetryItems[2].value, 300);
+
+  // garbage, then two frames in the same chunk
+  uint8_t chunk[2+sizeof(frames)] = { 0x55, 0xAA };
+  memcpy(&chunk[2], frames, sizeof(frames));
+  processCrossfireTelemetryData(chunk, sizeof(chunk));
+  EXPECT_EQ(telemetryItems[0].value, 122);
+  EXPECT_EQ(telemetryItems[1].value, 13);
+  EXPECT_EQ(telemetryItems[2].value, 301);
+  EXPECT_EQ(telemetryRxBufferCount, 0);
+
+  // a frame without payload is not processed, as with the byte parser
+  uint8_t empty[] = { RADIO_ADDRESS, 0x02, BATTERY_ID, 0x00 };
+  empty[3] = crc8(&empty[2], empty[1]-1);
+  processCrossfireTelemetryData(empty, sizeof(empty));
+  EXPECT_EQ(telemetryRxBufferCount, 4);
+  telemetryRxBufferCount = 0;
+}
+
+TEST(Crossfire, telemetryLinkStats)
+{
+  uint8_t frame[] = { RADIO_ADDRESS, 0x0A, BATTERY_ID, 0x00, 0x7B, 0x00, 0x0C, 0x00, 0x01, 0x2C, 0x50, 0x00 };
+  frame[11] = crc8(&frame[2], frame[1]-1);
+
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryRxBufferCount = 0;
+  telemetryLinkStatsReset();
+
+  processCrossfireTelemetryData(frame, sizeof(frame));
+  processCrossfireTelemetryData(frame, sizeof(frame));
+  EXPECT_EQ(telemetryLinkStats.frames, 2u);
+  EXPECT_EQ(telemetryLinkStats.gaps[0], 1u);
+
+  frame[11] ^= 0xFF;
+  processCrossfireTelemetryData(frame, sizeof(frame));
+  EXPECT_EQ(telemetryLinkStats.frames, 2u);
+  EXPECT_EQ(telemetryLinkStats.crcErrors, 1u);
+
+  // bad length byte
+  uint8_t garbage[] = { RADIO_ADDRESS, 0xFF };
+  processCrossfireTelemetryData(garbage, sizeof(garbage));
+  EXPECT_EQ(telemetryLinkStats.resyncs, 1u);
+  EXPECT_EQ(telemetryRxBufferCount, 0);
+}
 #endif
 
@@ -448,6 +448,75 @@ TEST(FrSkySPORT, frskySetCellVoltageTwoSensors)
 #endif
 }
 
+TEST(FrSkySPORT, calculatedSensorsOrder)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  // sensor 1 is computed from sensor 2, which is computed from the VFAS sensor
+  for (int i=0; i<2; i++) {
+    TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    sensor.label[0] = 1;
+    sensor.type = TELEM_TYPE_CALCULATED;
+    sensor.formula = TELEM_FORMULA_ADD;
+    sensor.unit = UNIT_VOLTS;
+    sensor.prec = 2;
+    sensor.calc.sources[0] = i + 2;
+  }
+
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, VFAS_FIRST_ID, 0, 0, 1234, UNIT_VOLTS, 2);
+  EXPECT_EQ(telemetryItems[2].value, 1234);
+
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[1].value, 1234);
+  EXPECT_EQ(telemetryItems[0].value, 1234);
+
+  // no source changed, the calculated sensors are not evaluated again
+  telemetryItems[0].value = 0;
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[0].value, 0);
+
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, VFAS_FIRST_ID, 0, 0, 1150, UNIT_VOLTS, 2);
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[1].value, 1150);
+  EXPECT_EQ(telemetryItems[0].value, 1150);
+}
+
+TEST(FrSkySPORT, calculatedSensorOverConsumption)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  // sensor 1 is the max of sensor 2, the consumption of the current sensor
+  TelemetrySensor & maxSensor = g_model.telemetrySensors[0];
+  maxSensor.label[0] = 1;
+  maxSensor.type = TELEM_TYPE_CALCULATED;
+  maxSensor.formula = TELEM_FORMULA_MAX;
+  maxSensor.unit = UNIT_MAH;
+  maxSensor.calc.sources[0] = 2;
+  TelemetrySensor & consumptionSensor = g_model.telemetrySensors[1];
+  consumptionSensor.label[0] = 1;
+  consumptionSensor.type = TELEM_TYPE_CALCULATED;
+  consumptionSensor.formula = TELEM_FORMULA_CONSUMPTION;
+  consumptionSensor.unit = UNIT_MAH;
+  consumptionSensor.consumption.source = 3;
+
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, CURR_FIRST_ID, 0, 0, 0, UNIT_AMPS, 1);
+  telemetryItems[1].per10ms(consumptionSensor);
+  telemetryWakeup();
+  EXPECT_TRUE(telemetryItems[0].isAvailable());
+  EXPECT_FALSE(telemetryItems[0].isOld());
+
+  // at 0A the consumption doesn't change, the max sensor is still refreshed
+  telemetryItems[0].setOld();
+  telemetryItems[1].per10ms(consumptionSensor);
+  telemetryWakeup();
+  EXPECT_FALSE(telemetryItems[0].isOld());
+  EXPECT_EQ(telemetryItems[0].value, 0);
+}
+
 void generateSportFasVoltagePacket(uint8_t * packet, uint32_t voltage)
 {
   packet[0] = 0x22; //DATA_ID_FAS
@@ -487,6 +556,37 @@ TEST(FrSkySPORT, frskyVfas)
   EXPECT_EQ(telemetryItems[0].valueMax, 6524);
 }
 
+TEST(FrSkySPORT, sensorsInstances)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  // two FAS with their own physical id
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1200, UNIT_VOLTS, 2);
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, VFAS_FIRST_ID, 0, 2, 1100, UNIT_VOLTS, 2);
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 1000, UNIT_VOLTS, 2);
+  EXPECT_EQ(telemetryItems[0].value, 1000);
+  EXPECT_EQ(telemetryItems[1].value, 1100);
+  EXPECT_FALSE(g_model.telemetrySensors[2].isAvailable());
+
+  // a copy of the first sensor gets the same values
+  g_model.telemetrySensors[2] = g_model.telemetrySensors[0];
+  storageDirty(EE_MODEL);
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, VFAS_FIRST_ID, 0, 1, 900, UNIT_VOLTS, 2);
+  EXPECT_EQ(telemetryItems[0].value, 900);
+  EXPECT_EQ(telemetryItems[1].value, 1100);
+  EXPECT_EQ(telemetryItems[2].value, 900);
+
+  // all sensors with this id are updated, whatever the instance
+  g_model.ignoreSensorIds = 1;
+  setTelemetryValue(TELEM_PROTO_FRSKY_SPORT, VFAS_FIRST_ID, 0, 3, 800, UNIT_VOLTS, 2);
+  EXPECT_EQ(telemetryItems[0].value, 800);
+  EXPECT_EQ(telemetryItems[1].value, 800);
+  EXPECT_EQ(telemetryItems[2].value, 800);
+  EXPECT_FALSE(g_model.telemetrySensors[3].isAvailable());
+}
+
 void generateSportFasCurrentPacket(uint8_t * packet, uint32_t current)
 {
   packet[0] = 0x22; //DATA_ID_FAS
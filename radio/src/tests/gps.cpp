@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(INTERNAL_GPS)
+bool gpsParseNMEA(const char * sentences, uint32_t chunkSize=64)
+{
+  bool result = false;
+  uint32_t count = strlen(sentences);
+  for (uint32_t i=0; i<count; i+=chunkSize) {
+    result |= gpsNewFrameNMEA((const uint8_t *)sentences+i, min(chunkSize, count-i));
+  }
+  return result;
+}
+
+TEST(Gps, nmeaSentences)
+{
+  memclear(&gpsData, sizeof(gpsData));
+
+  EXPECT_TRUE(gpsParseNMEA("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"));
+  EXPECT_EQ(gpsData.fix, 1);
+  EXPECT_EQ(gpsData.latitude, 48117300);
+  EXPECT_EQ(gpsData.longitude, 11516666);
+  EXPECT_EQ(gpsData.numSat, 8);
+  EXPECT_EQ(gpsData.altitude, 545);
+  EXPECT_EQ(gpsData.hdop, 90);
+
+  EXPECT_FALSE(gpsParseNMEA("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"));
+  EXPECT_EQ(gpsData.speed, 1152);
+  EXPECT_EQ(gpsData.groundCourse, 844);
+
+  gpsParseNMEA("$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n");
+  EXPECT_EQ(gpsData.speed, 282);
+  EXPECT_EQ(gpsData.groundCourse, 547);
+
+  gpsParseNMEA("$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.32,2.1*15\r\n");
+  EXPECT_EQ(gpsData.hdop, 132);
+
+  gpsParseNMEA("$GPGGA,123520,3348.1234,S,15112.5678,W,1,08,0.9,545.4,M,46.9,M,,*42\r\n");
+  EXPECT_EQ(gpsData.latitude, -33802056);
+  EXPECT_EQ(gpsData.longitude, -151209463);
+
+  EXPECT_EQ(gpsData.packetCount, 5u);
+  EXPECT_EQ(gpsData.errorCount, 0u);
+}
+
+TEST(Gps, nmeaChecksum)
+{
+  memclear(&gpsData, sizeof(gpsData));
+
+  // one digit changed, the sentence is dropped
+  gpsParseNMEA("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+  gpsParseNMEA("$GPGGA,123519,4907.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+  EXPECT_EQ(gpsData.latitude, 48117300);
+  EXPECT_EQ(gpsData.errorCount, 1u);
+
+  // lower case checksum
+  gpsParseNMEA("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6a\r\n");
+  EXPECT_EQ(gpsData.speed, 1152);
+
+  // truncated sentence, then a valid one
+  gpsParseNMEA("$GPGGA,123519,33$GPGGA,123520,3348.1234,S,15112.5678,W,1,08,0.9,545.4,M,46.9,M,,*42\r\n");
+  EXPECT_EQ(gpsData.latitude, -33802056);
+  EXPECT_EQ(gpsData.packetCount, 3u);
+}
+
+TEST(Gps, nmeaChunks)
+{
+  const char * sentences =
+    "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+    "$GPGGA,123520,3348.1234,S,15112.5678,W,1,08,0.9,545.4,M,46.9,M,,*42\r\n";
+
+  // the sentences split anywhere give the same result
+  for (uint32_t chunkSize=1; chunkSize<=8; chunkSize++) {
+    memclear(&gpsData, sizeof(gpsData));
+    EXPECT_TRUE(gpsParseNMEA(sentences, chunkSize));
+    EXPECT_EQ(gpsData.latitude, -33802056);
+    EXPECT_EQ(gpsData.longitude, -151209463);
+    EXPECT_EQ(gpsData.speed, 1152);
+    EXPECT_EQ(gpsData.packetCount, 2u);
+  }
+}
+#endif
@@ -61,6 +61,19 @@ inline void MODEL_RESET()
   extern uint8_t s_mixer_first_run_done;
   s_mixer_first_run_done = false;
   lastFlightMode = 255;
+#if defined(CPUARM)
+  invalidateMixerPlan();
+  invalidateLogicalSwitchesOrder();
+  invalidateTrimFlightModes();
+#if defined(GVARS)
+  invalidateGVarFlightModes();
+#endif
+  invalidateTelemetrySensorsIndex();
+  invalidateCalculatedSensorsOrder();
+#endif
+#if defined(CPUARM) && defined(CURVES)
+  resetCurveLuts();
+#endif
 }
 
 inline void MIXER_RESET()
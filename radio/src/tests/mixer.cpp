@@ -344,6 +344,25 @@ TEST_F(TrimsTest, infiniteChainedTrims)
 }
 #endif
 
+#if defined(CPUARM)
+TEST_F(TrimsTest, addedTrimsFlightModes)
+{
+  g_model.flightModeData[0].trim[RUD_STICK].value = 32;
+  g_model.flightModeData[1].trim[RUD_STICK].mode = 1; // FP1 trim is added to FP0 trim
+  g_model.flightModeData[1].trim[RUD_STICK].value = 10;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(getTrimValue(1, RUD_STICK), 42);
+
+  // trim values are read each time
+  g_model.flightModeData[0].trim[RUD_STICK].value = 20;
+  EXPECT_EQ(getTrimValue(1, RUD_STICK), 30);
+
+  g_model.flightModeData[1].trim[RUD_STICK].mode = 2; // FP1 own trim
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(getTrimValue(1, RUD_STICK), 10);
+}
+#endif
+
 TEST_F(TrimsTest, CopyTrimsToOffset)
 {
   setTrimValue(0, ELE_STICK, -100); // -100 on elevator
@@ -407,6 +426,129 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+#if defined(CPUARM)
+TEST(Curves, SmoothLut)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  modelDefault(0);
+
+  // CV1: 5 points heli pitch curve
+  static const int8_t cv1[] = {-100, 20, 30, 70, 90};
+  g_model.curves[0].smooth = 1;
+  memcpy(g_model.points, cv1, sizeof(cv1));
+
+  // CV2: 17 points curve with alternating slopes
+  g_model.curves[1].smooth = 1;
+  g_model.curves[1].points = 12;
+  for (int i=0; i<17; i++) {
+    g_model.points[5+i] = (i & 1) ? 100 - 10*i : -100 + 5*i;
+  }
+
+  // CV3: 6 points custom curve with uneven x
+  static const int8_t cv3[] = {-100, -80, 0, 10, 90, 100, /* x */ -90, -20, 0, 80};
+  g_model.curves[2].type = CURVE_TYPE_CUSTOM;
+  g_model.curves[2].smooth = 1;
+  g_model.curves[2].points = 1;
+  memcpy(&g_model.points[5+17], cv3, sizeof(cv3));
+
+  loadCurves();
+
+  for (int idx=0; idx<3; idx++) {
+    EXPECT_GE(curveLutSlot[idx], 0);
+    int maxError = 0;
+    for (int x=-RESX; x<=RESX; x++) {
+      maxError = max(maxError, abs(applyCustomCurve(x, idx) - hermite_spline(x, idx)));
+    }
+    // the table error stays below 8/2048 (0.4%) of the output range for
+    // the 17 points zig-zag, and below 2/2048 for the other curves
+    EXPECT_LE(maxError, idx==1 ? 8 : 2);
+    // values on the table grid are exact
+    for (int i=0; i<CURVE_LUT_POINTS; i++) {
+      int x = -RESX + i*CURVE_LUT_STEP;
+      EXPECT_EQ(hermite_spline(x, idx), applyCustomCurve(x, idx));
+    }
+  }
+
+  // an edited curve is read with hermite_spline() until the next mixer cycle
+  g_model.points[2] = 100;
+  invalidateCurveLut(0);
+  EXPECT_EQ(hermite_spline(0, 0), applyCustomCurve(0, 0));
+  int8_t slot = curveLutSlot[0];
+  EXPECT_NE(hermite_spline(0, 0), applyCurveLut(0, slot));
+  evalMixes(1);
+  EXPECT_EQ(slot, curveLutSlot[0]);
+  EXPECT_EQ(hermite_spline(0, 0), applyCurveLut(0, slot));
+}
+#endif
+
+
+#if defined(CPUARM)
+TEST(FlightModes, fadeOnlyDependentChannels)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  modelDefault(0);
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  // CH1 = Ail, doesn't depend on the flight mode
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_Ail;
+  g_model.mixData[0].weight = 100;
+  // CH2 = Ele, +50% in FM1 only
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_Ele;
+  g_model.mixData[1].weight = 100;
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].weight = 50;
+  g_model.mixData[2].flightModes = 0x01;
+  // CH3 = CH2
+  g_model.mixData[3].destCh = 2;
+  g_model.mixData[3].srcRaw = MIXSRC_CH2;
+  g_model.mixData[3].weight = 100;
+  g_model.flightModeData[1].swtch = SWSRC_SA0;
+  g_model.flightModeData[1].fadeIn = 10;
+  buildMixerPlan();
+  EXPECT_EQ(getFlightModesDependentChannels(0x03), (bitfield_channels_t)0x06);
+  EXPECT_EQ(getFlightModesDependentChannels(0x06), (bitfield_channels_t)0x00);
+  // FM2 with its own elevator trim, the trimmed channels depend on the flight mode
+  g_model.flightModeData[2].trim[1].mode = 2 << 1;
+  invalidateTrimFlightModes();
+  EXPECT_EQ(getFlightModesDependentChannels(0x06), (bitfield_channels_t)0x07);
+  g_model.flightModeData[2].trim[1].mode = 0;
+  invalidateTrimFlightModes();
+  EXPECT_EQ(getFlightModesDependentChannels(0x06), (bitfield_channels_t)0x00);
+
+  anaInValues[AIL_STICK] = 256;
+  anaInValues[ELE_STICK] = 128;
+  simuSetSwitch(0, 0);
+  lastFlightMode = 255;
+  evalMixes(1);
+  EXPECT_EQ(0, getFlightMode());
+  EXPECT_EQ(256, channelOutputs[0]);
+  EXPECT_EQ(128, channelOutputs[1]);
+
+  simuSetSwitch(0, -1);
+  for (int i=0; i<50; i++) {
+    evalMixes(1);
+    EXPECT_EQ(1, getFlightMode());
+    EXPECT_EQ(256, channelOutputs[0]);
+    EXPECT_GE(channelOutputs[1], 128);
+    EXPECT_LT(channelOutputs[1], 128+512);
+    EXPECT_EQ(channelOutputs[1], channelOutputs[2]);
+  }
+  EXPECT_GT(channelOutputs[1], 128);
+
+  // run mixes enough time to finish the fade (otherwise the mixer internal state flightModesFade could affect other tests)
+  for (int i=0; i<200; i++) {
+    evalMixes(1);
+  }
+  EXPECT_EQ(256, channelOutputs[0]);
+  EXPECT_EQ(128+512, channelOutputs[1]);
+}
+#endif
 
 #if !defined(CPUARM)
 TEST(FlightModes, nullFadeOut_posFadeIn)
@@ -983,3 +1125,131 @@ TEST(Trainer, UnpluggedTest)
   ppmInput[0] = 1024;
   CHECK_DELAY(0, 5000);
 }
+
+#if defined(CPUARM)
+TEST(Sources, getValue)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  modelDefault(0);
+  anas[1] = 345;
+  ppmInput[2] = 100;
+  ex_chans[3] = -512;
+  timersStates[1].val = 42;
+  telemetryItems[1].value = 1234;
+  telemetryItems[1].valueMin = -5;
+  telemetryItems[1].valueMax = 6789;
+
+  EXPECT_EQ(0, getValue(MIXSRC_NONE));
+  EXPECT_EQ(345, getValue(MIXSRC_FIRST_INPUT+1));
+  EXPECT_EQ(1024, getValue(MIXSRC_MAX));
+  EXPECT_EQ(200, getValue(MIXSRC_FIRST_TRAINER+2));
+  EXPECT_EQ(-512, getValue(MIXSRC_CH1+3));
+  EXPECT_EQ(42, getValue(MIXSRC_TIMER2));
+  EXPECT_EQ(1234, getValue(MIXSRC_FIRST_TELEM+3));
+  EXPECT_EQ(-5, getValue(MIXSRC_FIRST_TELEM+4));
+  EXPECT_EQ(6789, getValue(MIXSRC_FIRST_TELEM+5));
+  EXPECT_EQ(0, getValue(MIXSRC_LAST_TELEM+1));
+}
+#endif
+
+#if defined(CPUARM) && defined(GVARS)
+TEST_F(MixerTest, gvarsFlightModes)
+{
+  g_model.flightModeData[0].gvars[0] = 10;
+  g_model.flightModeData[1].gvars[0] = GVAR_MAX+1; // FP1 uses FP0 value
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(getGVarFlightMode(1, 0), 0);
+  EXPECT_EQ(getGVarValue(0, 1), 10);
+
+  g_model.flightModeData[1].gvars[0] = 5; // FP1 own value
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(getGVarFlightMode(1, 0), 1);
+  EXPECT_EQ(getGVarValue(0, 1), 5);
+}
+#endif
+
+#if defined(GVARS) && !defined(PCBSTD)
+TEST_F(MixerTest, gvarsFlightModesModelLoad)
+{
+  // first model, FP1 uses FP0 value
+  memclear(&g_model, sizeof(g_model));
+  g_model.flightModeData[0].gvars[0] = 10;
+  g_model.flightModeData[1].gvars[0] = GVAR_MAX+1;
+  postModelLoad(false);
+  EXPECT_EQ(getGVarValue(0, 1), 10);
+
+  // second model, FP1 own value
+  memclear(&g_model, sizeof(g_model));
+  g_model.flightModeData[0].gvars[0] = 10;
+  g_model.flightModeData[1].gvars[0] = 5;
+  postModelLoad(false);
+  EXPECT_EQ(getGVarValue(0, 1), 5);
+}
+#endif
+
+#if defined(DEBUG_LATENCY)
+TEST(Latency, histogram)
+{
+  LatencyHistogram histogram;
+  EXPECT_EQ(0u, histogram.getCount());
+  EXPECT_EQ(0u, histogram.getPercentile(50));
+
+  // 98 samples at 1ms, 2 at 10ms (2MHz ticks)
+  for (int i=0; i<98; i++) {
+    histogram.add(2000);
+  }
+  histogram.add(20000);
+  histogram.add(20000);
+
+  EXPECT_EQ(100u, histogram.getCount());
+  EXPECT_EQ(1000u, histogram.getMin());
+  EXPECT_EQ(10000u, histogram.getMax());
+  EXPECT_EQ(1250u, histogram.getPercentile(50));
+  EXPECT_EQ(1250u, histogram.getPercentile(98));
+  EXPECT_EQ(10000u, histogram.getPercentile(99));
+
+  // the last bucket is below the range end (63500 ticks)
+  histogram.add(60000);
+  EXPECT_EQ(1u, histogram.getBucket(60000 / LATENCY_BUCKET_WIDTH));
+  EXPECT_EQ(0u, histogram.getBucket(LATENCY_BUCKETS-1));
+
+  // out of range samples go to the last bucket
+  histogram.add(65000);
+  EXPECT_EQ(1u, histogram.getBucket(LATENCY_BUCKETS-1));
+  EXPECT_EQ(32000u, histogram.getPercentile(100));
+
+  histogram.reset();
+  EXPECT_EQ(0u, histogram.getCount());
+}
+#endif
+
+#if defined(INPUTS_RECORDER)
+TEST(Recorder, encodeDecode)
+{
+  static RecordSnapshot previous, current, decoded;
+  static uint8_t frame[RECORD_FRAME_MAX_SIZE];
+  memclear(&previous, sizeof(previous));
+  memclear(&decoded, sizeof(decoded));
+
+  // unchanged snapshot: only the ticks and the groups bitmap
+  current = previous;
+  EXPECT_EQ(uint32_t(1 + RECORD_GROUPS_BYTES), recordEncodeFrame(frame, previous, current, 2));
+
+  // 3 words in 3 different groups
+  current.words[0] = -1024;
+  current.words[8] = 0x1234;
+  current.words[RECORD_SNAPSHOT_WORDS-1] = 0xFFFF;
+  uint32_t size = recordEncodeFrame(frame, previous, current, 3);
+  EXPECT_EQ(uint32_t(1 + RECORD_GROUPS_BYTES + 3 + 3*2), size);
+
+  uint8_t ticks = 0;
+  EXPECT_EQ(frame + size, recordDecodeFrame(frame, frame + size, decoded, ticks));
+  EXPECT_EQ(3, ticks);
+  EXPECT_EQ(0, memcmp(&current, &decoded, sizeof(current)));
+
+  // truncated frame
+  EXPECT_TRUE(recordDecodeFrame(frame, frame + size - 1, decoded, ticks) == NULL);
+}
+#endif
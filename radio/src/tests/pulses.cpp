@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(CPUARM)
+#include "pulses/channels_packer.h"
+
+// the former encoders loop
+uint8_t * packChannelsReference(uint8_t * frame, const uint32_t * values, unsigned bitsPerChannel, unsigned count)
+{
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (unsigned i=0; i<count; i++) {
+    bits |= values[i] << bitsavailable;
+    bitsavailable += bitsPerChannel;
+    while (bitsavailable >= 8) {
+      *frame++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+  if (bitsavailable > 0) {
+    *frame++ = bits;
+  }
+  return frame;
+}
+
+template <unsigned BITS, unsigned COUNT>
+void checkChannelsPacker()
+{
+  typedef ChannelsPacker<BITS, COUNT> Packer;
+  uint32_t values[COUNT];
+  uint8_t frame[Packer::SIZE + 4];
+  uint8_t reference[Packer::SIZE + 4];
+
+  for (unsigned channel=0; channel<COUNT; channel++) {
+    for (uint32_t value=0; value<(1u << BITS); value+=(BITS > 12 ? 7 : 1)) {
+      for (unsigned i=0; i<COUNT; i++) {
+        values[i] = (i == channel ? value : (i * 0x9E3779B1u + value) >> (32 - BITS));
+      }
+      memset(frame, 0xAA, sizeof(frame));
+      memset(reference, 0xAA, sizeof(reference));
+      uint8_t * end = Packer::pack(frame, [&](unsigned i) { return values[i]; });
+      ASSERT_EQ(packChannelsReference(reference, values, BITS, COUNT) - reference, end - frame);
+      ASSERT_EQ(0, memcmp(frame, reference, sizeof(frame))) << "channel " << channel << " value " << value;
+    }
+  }
+}
+
+TEST(Pulses, channelsPacker)
+{
+  checkChannelsPacker<11, 16>();
+  checkChannelsPacker<11, 1>();
+  checkChannelsPacker<11, 3>();
+  checkChannelsPacker<8, 5>();
+  checkChannelsPacker<10, 8>();
+  checkChannelsPacker<12, 9>();
+  checkChannelsPacker<16, 4>();
+  checkChannelsPacker<16, 3>();
+}
+
+TEST(Pulses, scaleChannelOutput)
+{
+  for (int value=-2048; value<=2048; value++) {
+    // CRSF
+    EXPECT_EQ(limit(0, 0x3E0 + ((value * 4) / 5), 2*0x3E0), (int)scaleChannelOutput(value, 0x3E0, 2*0x3E0));
+    // MULTI
+    EXPECT_EQ(limit(0, value * 800 / 1000 + 1024, 2047), (int)scaleChannelOutput(value, 1024, 2047));
+    // SBUS
+    EXPECT_EQ(limit(0, value * 8 / 10 + 992, 2047), (int)scaleChannelOutput(value, 992, 2047));
+  }
+}
+#endif
@@ -93,6 +93,49 @@ TEST(getSwitch, OldTypeStickyCSW)
 }
 #endif
 
+#if defined(PCBTARANIS)
+TEST(evalLogicalSwitches, forwardReference)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 depends on L2 which is evaluated first
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SW2, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_SA0, SWSRC_NONE);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+  EXPECT_EQ(lswLoopIndex, -1);
+
+  // both switches change in the same cycle
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+}
+
+TEST(evalLogicalSwitches, loopDetection)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // a switch which references itself is not a loop
+  setLogicalSwitch(0, LS_FUNC_OR, SWSRC_SW1, SWSRC_SA0);
+  evalLogicalSwitches();
+  EXPECT_EQ(lswLoopIndex, -1);
+
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_SW3, SWSRC_NONE);
+  setLogicalSwitch(2, LS_FUNC_VPOS, MIXSRC_SW1+1, 0);
+  invalidateLogicalSwitchesOrder();
+  evalLogicalSwitches();
+  EXPECT_EQ(lswLoopIndex, 1);
+}
+#endif
+
 TEST(getSwitch, nullSW)
 {
   MODEL_RESET();
@@ -643,6 +643,7 @@ const pm_char STR_BLCOLOR[]  PROGMEM = TR_BLCOLOR;
   const pm_char STR_CRITICALALARM[] PROGMEM = TR_CRITICALALARM;
   const pm_char STR_RSSIALARM_WARN[] PROGMEM = TR_RSSIALARM_WARN;
   const pm_char STR_NO_RSSIALARM[] PROGMEM = TR_NO_RSSIALARM;
+  const pm_char STR_LSW_LOOP[] PROGMEM = TR_LSW_LOOP;
   const pm_char STR_DISABLE_ALARM[] PROGMEM = TR_DISABLE_ALARM;
   const pm_char STR_TELEMETRY_TYPE[] PROGMEM = TR_TELEMETRY_TYPE;
   const pm_char STR_TELEMETRY_SENSORS[] PROGMEM = TR_TELEMETRY_SENSORS;
@@ -952,6 +952,7 @@ extern const pm_char STR_BLCOLOR[];
   extern const pm_char STR_CRITICALALARM[];
   extern const pm_char STR_RSSIALARM_WARN[];
   extern const pm_char STR_NO_RSSIALARM[];
+  extern const pm_char STR_LSW_LOOP[];
   extern const pm_char STR_DISABLE_ALARM[];
   extern const pm_char STR_TELEMETRY_TYPE[];
   extern const pm_char STR_TELEMETRY_SENSORS[];
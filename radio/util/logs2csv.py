@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+"""
+    This script converts a fast (binary) log, recorded by a Logs special
+    function with a period in ms, to CSV
+
+    Usage:
+
+        ./logs2csv.py MODEL-2018-01-01-123456.bin [output.csv]
+"""
+
+from __future__ import division, print_function
+
+import sys, struct, datetime
+
+LOGS_FAST_FOURCC = 0x4C58544F
+LOGS_FAST_VERSION = 1
+
+HEADER = struct.Struct("<IBBHI")
+COLUMN = struct.Struct("<8s4sBB")
+RECORD_TIME = struct.Struct("<I")
+VALUE_FORMATS = {2: "h", 4: "i"}
+
+
+def text(value):
+    return value.split(b"\0", 1)[0].decode("ascii", "replace").strip()
+
+
+def formatValue(value, precision):
+    if precision == 0:
+        return str(value)
+    sign = "-" if value < 0 else ""
+    qr = divmod(abs(value), 10 ** precision)
+    return "%s%d.%0*d" % (sign, qr[0], precision, qr[1])
+
+
+def convert(inp, out):
+    data = inp.read(HEADER.size)
+    if len(data) < HEADER.size:
+        raise ValueError("file too short")
+    fourcc, version, period, count, startTime = HEADER.unpack(data)
+    if fourcc != LOGS_FAST_FOURCC:
+        raise ValueError("not a fast log file")
+    if version != LOGS_FAST_VERSION:
+        raise ValueError("unsupported version %d" % version)
+
+    columns = []
+    for i in range(count):
+        name, unit, precision, size = COLUMN.unpack(inp.read(COLUMN.size))
+        if size not in VALUE_FORMATS:
+            raise ValueError("invalid size %d for column %d" % (size, i))
+        columns.append((text(name), text(unit), precision, size))
+
+    record = struct.Struct("<I" + "".join(VALUE_FORMATS[size] for _, _, _, size in columns))
+
+    if startTime:
+        header = ["Date", "Time"]
+    else:
+        header = ["Time(ms)"]
+    for name, unit, _, _ in columns:
+        header.append("%s(%s)" % (name, unit) if unit else name)
+    out.write(",".join(header) + "\n")
+
+    start = datetime.datetime(1970, 1, 1) + datetime.timedelta(seconds=startTime)
+    records = 0
+    while True:
+        data = inp.read(record.size)
+        if len(data) < record.size:
+            break
+        values = record.unpack(data)
+        if startTime:
+            time = start + datetime.timedelta(milliseconds=values[0])
+            line = [time.strftime("%Y-%m-%d"), time.strftime("%H:%M:%S.") + "%03d" % (time.microsecond // 1000)]
+        else:
+            line = [str(values[0])]
+        for (_, _, precision, _), value in zip(columns, values[1:]):
+            line.append(formatValue(value, precision))
+        out.write(",".join(line) + "\n")
+        records += 1
+
+    print("%d columns, %d records, period %dms" % (count, records, period), file=sys.stderr)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__, file=sys.stderr)
+        sys.exit(1)
+
+    with open(sys.argv[1], "rb") as inp:
+        if len(sys.argv) > 2:
+            with open(sys.argv[2], "w") as out:
+                convert(inp, out)
+        else:
+            convert(inp, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()